@@ -0,0 +1,80 @@
+#ifndef BEAMSELECT_H
+#define BEAMSELECT_H
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <unordered_set>
+
+// ==========================================
+// Bounded Top-K Selection (shared by every beam loop)
+// Selection runs on (key, index) pairs only, so candidates / nodes are never moved
+// while choosing the survivors. Ties on the key are broken by the original index,
+// which keeps the beam deterministic.
+// Cost: O(n) partition (nth_element) + O(K log K) to order the K survivors.
+// ==========================================
+
+// Indices of the K items with the smallest key, best first
+template <typename T, typename KeyFn>
+std::vector<int> selectTopK(const std::vector<T>& items, size_t k, KeyFn key) {
+    typedef typename std::decay<decltype(key(std::declval<const T&>()))>::type Key;
+
+    std::vector<std::pair<Key, int>> keyed;
+    keyed.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) keyed.push_back(std::make_pair(key(items[i]), (int)i));
+
+    if (keyed.size() > k) {
+        std::nth_element(keyed.begin(), keyed.begin() + k, keyed.end());
+        keyed.resize(k);
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<int> indices;
+    indices.reserve(keyed.size());
+    for (const auto& kv : keyed) indices.push_back(kv.second);
+    return indices;
+}
+
+// Same as selectTopK, but drops duplicate states: for every state hash only the
+// best-scoring item survives (ties -> lower index), so equivalent states reached by
+// different move orders do not take several beam slots.
+// Items are visited in (key, index) order, one partially sorted chunk at a time,
+// so the common case stays O(n) + O(K log K).
+template <typename T, typename KeyFn, typename HashFn>
+std::vector<int> selectTopKUnique(const std::vector<T>& items, size_t k, KeyFn key, HashFn hash) {
+    typedef typename std::decay<decltype(key(std::declval<const T&>()))>::type Key;
+
+    std::vector<std::pair<Key, int>> keyed;
+    keyed.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) keyed.push_back(std::make_pair(key(items[i]), (int)i));
+
+    std::vector<int> indices;
+    std::unordered_set<unsigned long long> seen;
+    seen.reserve(2 * k);
+
+    size_t begin = 0;
+    while (indices.size() < k && begin < keyed.size()) {
+        size_t end = std::min(keyed.size(), begin + 2 * (k - indices.size()));
+        if (end < keyed.size()) std::nth_element(keyed.begin() + begin, keyed.begin() + end, keyed.end());
+        std::sort(keyed.begin() + begin, keyed.begin() + end);
+
+        for (size_t i = begin; i < end && indices.size() < k; ++i) {
+            if (seen.insert(hash(items[keyed[i].second])).second) indices.push_back(keyed[i].second);
+        }
+        begin = end;
+    }
+    return indices;
+}
+
+// Keep only the K best items of a beam (best first); each survivor is moved exactly once
+template <typename T, typename KeyFn>
+void keepTopK(std::vector<T>& items, size_t k, KeyFn key) {
+    std::vector<int> indices = selectTopK(items, k, key);
+    std::vector<T> kept;
+    kept.reserve(indices.size());
+    for (int idx : indices) kept.push_back(std::move(items[idx]));
+    items.swap(kept);
+}
+
+#endif // BEAMSELECT_H
@@ -0,0 +1,502 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+#include "DataGenerator.h"
+#include "YardSystem.h"
+#include "MakespanSolver.h"
+#include "GeneticAlgorithm.h"
+#include "MissionSimulator.h"
+
+// ==========================================
+// Native Benchmark Suite
+// Micro: yard operations and the scoring functions of one expansion
+//        (moveBox, yard / node copy, getBlockingBoxes, penalties, 3D UBALB, destination index)
+// Macro: one beam layer, a full MakespanSolver::solve (every column / best-k destinations),
+//        one GA generation, a replay of the plan
+// Every scenario is a yard generated by DataGenerator.h with a fixed seed, so runs
+// on the same machine are comparable from commit to commit.
+// Build: g++ -O2 -std=c++11 -pthread Benchmark.cpp -o benchmark
+// Usage: ./benchmark [--quick] [--json FILE] [--csv FILE]
+// ==========================================
+
+// --- Parameters ---
+const unsigned int BENCH_SEED = 42;
+const int MISSION_COUNT = 30;
+const int REPEATS = 5;                 // timings per benchmark, the median is reported
+const double MIN_REPEAT_SEC = 0.05;    // each timing runs the operation for at least this long
+const int LAYER_BEAM_WIDTH = 100;      // beam of the single-layer benchmark
+const int SOLVE_BEAM_WIDTH = 20;
+const int GA_EVAL_BEAM_WIDTH = 5;
+const int GA_POPULATION = 16;
+const int GA_GENERATIONS = 3;          // timed generations (the initial population is excluded)
+const int DESTINATION_CANDIDATES = 8;  // "_k" benchmarks: destinations per node from the yard's index
+
+struct Scenario {
+    int rows;
+    int bays;
+    int levels;
+    double fill;  // boxes / capacity
+};
+
+struct BenchResult {
+    std::string suite;     // micro / macro
+    std::string name;
+    Scenario scenario;
+    int boxes;
+    long long iterations;  // operations timed over all repeats
+    double medianNs;       // per operation
+    double minNs;
+    double itemsPerOp;     // e.g. candidates scored per layer (0 = n/a)
+};
+
+// Keeps results alive so the optimizer cannot drop the measured work
+static volatile double g_sink = 0;
+
+// Legacy nested layout (before flat storage), kept here only as the "before" reference
+struct NestedYardLayout {
+    std::vector<std::vector<std::vector<int>>> grid;
+    std::vector<Coordinate> boxLocations;
+    std::vector<std::vector<int>> tops;
+    int MAX_ROWS;
+    int MAX_BAYS;
+    int MAX_TIERS;
+
+    NestedYardLayout(const YardSystem& yard)
+        : MAX_ROWS(yard.MAX_ROWS), MAX_BAYS(yard.MAX_BAYS), MAX_TIERS(yard.MAX_TIERS) {
+        grid.resize(MAX_ROWS, std::vector<std::vector<int>>(MAX_BAYS, std::vector<int>(MAX_TIERS, 0)));
+        tops.resize(MAX_ROWS, std::vector<int>(MAX_BAYS, 0));
+        boxLocations.resize(yard.BOX_CAPACITY, {-1, -1, -1});
+        for (int r = 0; r < MAX_ROWS; ++r) {
+            for (int b = 0; b < MAX_BAYS; ++b) {
+                tops[r][b] = yard.getHeight(r, b);
+                for (int t = 0; t < MAX_TIERS; ++t) grid[r][b][t] = yard.getBoxAt(r, b, t);
+            }
+        }
+        for (int id = 0; id < yard.BOX_CAPACITY; ++id) boxLocations[id] = yard.getBoxPosition(id);
+    }
+};
+
+class BenchmarkRunner {
+public:
+    std::vector<BenchResult> results;
+
+    // fn() performs opsPerCall operations; batches of calls are timed until MIN_REPEAT_SEC
+    // has passed, REPEATS times over
+    template <typename Fn>
+    void measure(const std::string& suite, const std::string& name, const Scenario& sc, int boxes,
+                 Fn fn, int opsPerCall, double itemsPerOp = 0) {
+        std::vector<double> perOp;
+        long long total = 0;
+        fn();  // warm-up
+        for (int rep = 0; rep < REPEATS; ++rep) {
+            long long calls = 0;
+            double elapsed = 0;
+            auto start = std::chrono::steady_clock::now();
+            do {
+                fn();
+                calls++;
+                elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            } while (elapsed < MIN_REPEAT_SEC);
+            perOp.push_back(elapsed * 1e9 / (double)(calls * opsPerCall));
+            total += calls * opsPerCall;
+        }
+        record(suite, name, sc, boxes, perOp, total, itemsPerOp);
+    }
+
+    // For operations that need untimed setup each call: fn() returns its own duration in ns
+    template <typename Fn>
+    void measureManual(const std::string& suite, const std::string& name, const Scenario& sc, int boxes,
+                       Fn fn, double itemsPerOp = 0) {
+        std::vector<double> perOp;
+        long long total = 0;
+        fn();  // warm-up
+        for (int rep = 0; rep < REPEATS; ++rep) {
+            long long calls = 0;
+            double spent = 0;
+            auto start = std::chrono::steady_clock::now();
+            do {
+                spent += fn();
+                calls++;
+            } while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < MIN_REPEAT_SEC);
+            perOp.push_back(spent / (double)calls);
+            total += calls;
+        }
+        record(suite, name, sc, boxes, perOp, total, itemsPerOp);
+    }
+
+    // One measured value per repeat (operations too slow to loop)
+    void recordSamples(const std::string& suite, const std::string& name, const Scenario& sc, int boxes,
+                       std::vector<double> perOpNs, long long total, double itemsPerOp = 0) {
+        record(suite, name, sc, boxes, perOpNs, total, itemsPerOp);
+    }
+
+private:
+    void record(const std::string& suite, const std::string& name, const Scenario& sc, int boxes,
+                std::vector<double> perOp, long long total, double itemsPerOp) {
+        std::sort(perOp.begin(), perOp.end());
+        BenchResult r;
+        r.suite = suite;
+        r.name = name;
+        r.scenario = sc;
+        r.boxes = boxes;
+        r.iterations = total;
+        r.medianNs = perOp[perOp.size() / 2];
+        r.minNs = perOp.front();
+        r.itemsPerOp = itemsPerOp;
+        results.push_back(r);
+
+        std::ostringstream label;
+        label << sc.rows << "x" << sc.bays << "x" << sc.levels << " @" << (int)(sc.fill * 100 + 0.5) << "%";
+        std::ostringstream value;
+        value << std::fixed << std::setprecision(1);
+        if (r.medianNs >= 1e6) value << r.medianNs / 1e6 << " ms";
+        else if (r.medianNs >= 1e3) value << r.medianNs / 1e3 << " us";
+        else value << r.medianNs << " ns";
+        std::cout << std::left << std::setw(6) << suite << std::setw(26) << name << std::setw(16) << label.str()
+                  << std::right << std::setw(12) << value.str();
+        if (itemsPerOp > 0) std::cout << "  (" << std::fixed << std::setprecision(0) << itemsPerOp << " items/op)";
+        std::cout << std::endl;
+    }
+};
+
+// --- Scenario setup ---
+
+struct Instance {
+    YardSystem yard;          // ranks of `seq` attached
+    int boxes;
+    std::vector<int> seq;     // retrieval order; the most deeply buried target first
+    MakespanSolver::SolveTables tables;
+};
+
+static bool buildInstance(const Scenario& sc, const MakespanSolver& solver, Instance& inst) {
+    int capacity = sc.rows * sc.bays * sc.levels;
+    int boxes = (int)(capacity * sc.fill);
+    std::mt19937 rng(BENCH_SEED);
+    GeneratedYard generated;
+    if (!generateYard(sc.rows, sc.bays, sc.levels, boxes, std::min(MISSION_COUNT, boxes), rng, generated)) return false;
+
+    inst.boxes = boxes;
+    inst.yard = YardSystem(sc.rows, sc.bays, sc.levels, boxes);
+    for (const auto& box : generated.boxes) inst.yard.initBox(box.id, box.row, box.bay, box.level);
+    inst.seq.clear();
+    for (const auto& box : generated.targets) inst.seq.push_back(box.id);
+
+    // The single-layer benchmark expands the first target: make it the one with the most blockers
+    size_t deepest = 0;
+    for (size_t i = 0; i < inst.seq.size(); ++i) {
+        if (inst.yard.getBlockingBoxes(inst.seq[i]).size() > inst.yard.getBlockingBoxes(inst.seq[deepest]).size()) deepest = i;
+    }
+    std::swap(inst.seq[0], inst.seq[deepest]);
+
+    solver.buildSolveTables(inst.tables, inst.yard, inst.seq);
+    inst.yard.attachRanks(inst.tables.rankOf);
+    return true;
+}
+
+static SolverConfig benchConfig(int beamWidth, int destinations = 0) {
+    SolverConfig config;
+    config.beamWidth = beamWidth;
+    config.destinationCandidates = destinations;
+    return config;
+}
+
+// --- Micro benchmarks ---
+
+static void runMicro(BenchmarkRunner& bench, const Scenario& sc, const Instance& inst, const MakespanSolver& solver) {
+    const YardSystem& base = inst.yard;
+    int boxes = inst.boxes;
+    int columns = base.MAX_ROWS * base.MAX_BAYS;
+
+    // moveBox: out and back again, so the yard returns to its initial state
+    std::vector<std::pair<int, int>> moves;  // (src column, dst column)
+    for (int s = 0; s < columns && moves.size() < 256; ++s) {
+        for (int d = 0; d < columns && moves.size() < 256; ++d) {
+            if (s == d) continue;
+            if (base.getHeight(s / base.MAX_BAYS, s % base.MAX_BAYS) == 0) continue;
+            if (!base.canReceiveBox(d / base.MAX_BAYS, d % base.MAX_BAYS)) continue;
+            moves.push_back(std::make_pair(s, d));
+        }
+    }
+    if (!moves.empty()) {
+        YardSystem yard = base;
+        bench.measure("micro", "yard.moveBox", sc, boxes, [&]() {
+            for (const auto& m : moves) {
+                yard.moveBox(m.first / yard.MAX_BAYS, m.first % yard.MAX_BAYS, m.second / yard.MAX_BAYS, m.second % yard.MAX_BAYS);
+                yard.moveBox(m.second / yard.MAX_BAYS, m.second % yard.MAX_BAYS, m.first / yard.MAX_BAYS, m.first % yard.MAX_BAYS);
+            }
+            g_sink = (double)yard.stateHash;
+        }, (int)moves.size() * 2);
+
+        // Same moves with the destination index kept up to date
+        yard.enableDestinationIndex();
+        bench.measure("micro", "yard.moveBox_indexed", sc, boxes, [&]() {
+            for (const auto& m : moves) {
+                yard.moveBox(m.first / yard.MAX_BAYS, m.first % yard.MAX_BAYS, m.second / yard.MAX_BAYS, m.second % yard.MAX_BAYS);
+                yard.moveBox(m.second / yard.MAX_BAYS, m.second % yard.MAX_BAYS, m.first / yard.MAX_BAYS, m.first % yard.MAX_BAYS);
+            }
+            g_sink = (double)yard.stateHash;
+        }, (int)moves.size() * 2);
+    }
+
+    // Copies: one per surviving candidate in the expansion
+    {
+        std::vector<YardSystem> sink(64);
+        size_t k = 0;
+        bench.measure("micro", "yard.copy", sc, boxes, [&]() {
+            sink[k++ & 63] = base;
+        }, 1);
+        NestedYardLayout nested(base);
+        std::vector<NestedYardLayout> nestedSink(64, nested);
+        bench.measure("micro", "yard.copy_nested_legacy", sc, boxes, [&]() {
+            nestedSink[k++ & 63] = nested;
+        }, 1);
+        SearchNode root = solver.makeRoot(base, inst.tables, inst.seq);
+        std::vector<SearchNode> nodeSink(64, root);
+        bench.measure("micro", "node.copy", sc, boxes, [&]() {
+            nodeSink[k++ & 63] = root;
+        }, 1);
+    }
+
+    bench.measure("micro", "yard.getBlockingBoxes", sc, boxes, [&]() {
+        size_t n = 0;
+        for (int id : inst.seq) n += base.getBlockingBoxes(id).size();
+        g_sink = (double)n;
+    }, (int)inst.seq.size());
+
+    // Penalties of every destination column for the top blocker of the first target
+    std::vector<int> blockers = base.getBlockingBoxes(inst.seq[0]);
+    int movingBoxId = blockers.empty() ? inst.seq[0] : blockers.back();
+    bench.measure("micro", "penalty.ril", sc, boxes, [&]() {
+        double total = 0;
+        for (int r = 0; r < base.MAX_ROWS; ++r) {
+            for (int b = 0; b < base.MAX_BAYS; ++b) total += solver.calculateRILPenalty(base, r, b, 0, movingBoxId);
+        }
+        g_sink = total;
+    }, columns);
+    bench.measure("micro", "penalty.return", sc, boxes, [&]() {
+        int total = 0;
+        for (int r = 0; r < base.MAX_ROWS; ++r) {
+            for (int b = 0; b < base.MAX_BAYS; ++b) total += MakespanSolver::calculateReturnPenalty(base, r, b, 0);
+        }
+        g_sink = total;
+    }, columns);
+
+    // Destinations of that blocker: the best DESTINATION_CANDIDATES from the index
+    {
+        YardSystem yard = base;
+        yard.enableDestinationIndex();
+        Coordinate src = base.getBoxPosition(movingBoxId);
+        std::vector<int> out;
+        bench.measure("micro", "index.best_destinations", sc, boxes, [&]() {
+            yard.bestDestinations(DESTINATION_CANDIDATES, src.row, src.bay, yard.columnIndex(src.row, src.bay), out);
+            g_sink = (double)out.size();
+        }, 1, DESTINATION_CANDIDATES);
+    }
+
+    // Heuristic: the full rescan (root only) against the per-child incremental update
+    bench.measure("micro", "heuristic.ubalb_full", sc, boxes, [&]() {
+        g_sink = MakespanSolver::calculate3DUbalb(base, inst.tables, inst.seq, 0);
+    }, 1);
+    bench.measure("micro", "heuristic.ubalb_delta", sc, boxes, [&]() {
+        double total = 0;
+        for (int r = 0; r < base.MAX_ROWS; ++r) {
+            for (int b = 0; b < base.MAX_BAYS; ++b) total += MakespanSolver::ubalbAfterDrop(base, inst.tables, 0.0, r, b, 0);
+        }
+        g_sink = total;
+    }, columns);
+}
+
+// --- Macro benchmarks ---
+
+static void runMacro(BenchmarkRunner& bench, const Scenario& sc, const Instance& inst, bool quick) {
+    int boxes = inst.boxes;
+
+    // One beam layer: grow a beam on the first target, then time expanding it once more.
+    // "_k" variants take DESTINATION_CANDIDATES destinations per node from the yard's index.
+    for (int destinations : {0, DESTINATION_CANDIDATES}) {
+        std::string suffix = destinations > 0 ? "_k" : "";
+        MakespanSolver solver(benchConfig(LAYER_BEAM_WIDTH, destinations));
+        MakespanSolver::LayerWorkspace ws;
+        std::vector<SearchNode> beam(1, solver.makeRoot(inst.yard, inst.tables, inst.seq));
+        std::vector<SearchNode> next = beam;
+        int layer = 1;
+        bool done = false;
+        while (layer < 40) {
+            if (solver.expandLayer(next, ws, inst.seq[0], 0, layer, LAYER_BEAM_WIDTH, inst.tables, nullptr, done) == 0 || done) break;
+            beam = next;
+            layer++;
+            if ((int)beam.size() >= LAYER_BEAM_WIDTH) break;
+        }
+
+        // Candidates scored per layer (the same every call)
+        std::vector<SearchNode> work = beam;
+        bool cycleDone = false;
+        size_t scored = solver.expandLayer(work, ws, inst.seq[0], 0, layer, LAYER_BEAM_WIDTH, inst.tables, nullptr, cycleDone);
+        bench.measureManual("macro", "beam.layer" + suffix, sc, boxes, [&]() {
+            work = beam;
+            auto start = std::chrono::steady_clock::now();
+            solver.expandLayer(work, ws, inst.seq[0], 0, layer, LAYER_BEAM_WIDTH, inst.tables, nullptr, cycleDone);
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }, (double)scored);
+    }
+
+    // Full solve with mission history
+    for (int destinations : {0, DESTINATION_CANDIDATES}) {
+        std::string suffix = destinations > 0 ? "_k" : "";
+        MakespanSolver solver(benchConfig(SOLVE_BEAM_WIDTH, destinations));
+        std::vector<double> samples;
+        int repeats = quick ? 1 : 3;
+        size_t missions = 0;
+        for (int rep = 0; rep < repeats; ++rep) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<MissionLog> logs = solver.solve(inst.yard, inst.seq);
+            samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+            missions = logs.size();
+        }
+        bench.recordSamples("macro", "solve.full" + suffix, sc, boxes, samples, repeats, (double)missions);
+        if (destinations > 0) continue;
+
+        // Event-driven replay of that plan (MissionSimulator.h)
+        std::vector<MissionLog> logs = solver.solve(inst.yard, inst.seq);
+        MissionSimulator simulator(inst.yard, solver.getConfig());
+        bench.measure("macro", "simulate.replay", sc, boxes, [&]() {
+            g_sink = simulator.run(logs).makespan;
+        }, 1, (double)logs.size());
+    }
+
+    // GA generations (selection + crossover + mutation + fitness of the offspring);
+    // the initial population and the final re-evaluation are not counted
+    {
+        GAConfig gaConfig;
+        gaConfig.populationSize = GA_POPULATION;
+        gaConfig.maxGenerations = GA_GENERATIONS + 1;
+        gaConfig.verbose = false;
+        MakespanObjective objective(inst.yard, benchConfig(GA_EVAL_BEAM_WIDTH));
+        GeneticAlgorithm<MakespanObjective> ga(objective, inst.seq, BENCH_SEED, gaConfig);
+        std::vector<double> stamps;
+        ga.setProgressCallback([&](const GAProgress& p) {
+            stamps.push_back(p.elapsedSec);
+            return true;
+        });
+        ga.solve();
+
+        std::vector<double> samples;
+        for (size_t g = 1; g < stamps.size(); ++g) samples.push_back((stamps[g] - stamps[g - 1]) * 1e9);
+        if (!samples.empty()) bench.recordSamples("macro", "ga.generation", sc, boxes, samples, (long long)samples.size(), GA_POPULATION);
+    }
+}
+
+// --- Output ---
+
+static std::string compilerVersion() {
+#ifdef __VERSION__
+    return __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+static std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+static bool writeJson(const std::string& path, const std::vector<BenchResult>& results, bool quick) {
+    std::ofstream file(path);
+    if (!file) return false;
+    bool openmp = false;
+#ifdef _OPENMP
+    openmp = true;
+#endif
+    file << std::setprecision(10);
+    file << "{\n  \"meta\": {\"compiler\": \"" << jsonEscape(compilerVersion()) << "\", \"openmp\": " << (openmp ? "true" : "false")
+         << ", \"quick\": " << (quick ? "true" : "false") << ", \"seed\": " << BENCH_SEED
+         << ", \"missions\": " << MISSION_COUNT << ", \"timestamp\": " << (long long)std::time(nullptr) << "},\n";
+    file << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        file << "    {\"suite\": \"" << r.suite << "\", \"name\": \"" << r.name << "\", \"rows\": " << r.scenario.rows
+             << ", \"bays\": " << r.scenario.bays << ", \"levels\": " << r.scenario.levels << ", \"fill\": " << r.scenario.fill
+             << ", \"boxes\": " << r.boxes << ", \"iterations\": " << r.iterations << ", \"ns_per_op_median\": " << r.medianNs
+             << ", \"ns_per_op_min\": " << r.minNs << ", \"items_per_op\": " << r.itemsPerOp << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return true;
+}
+
+static bool writeCsv(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream file(path);
+    if (!file) return false;
+    file << std::setprecision(10);
+    file << "suite,name,rows,bays,levels,fill,boxes,iterations,ns_per_op_median,ns_per_op_min,items_per_op\n";
+    for (const auto& r : results) {
+        file << r.suite << "," << r.name << "," << r.scenario.rows << "," << r.scenario.bays << "," << r.scenario.levels << ","
+             << r.scenario.fill << "," << r.boxes << "," << r.iterations << "," << r.medianNs << "," << r.minNs << ","
+             << r.itemsPerOp << "\n";
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    std::string jsonPath, csvPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) quick = true;
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csvPath = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--json FILE] [--csv FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Default DataGenerator yard (6x11x8, 400 boxes ~ 76%) at three fill ratios, plus two larger yards
+    std::vector<Scenario> scenarios;
+    if (quick) {
+        scenarios.push_back({6, 11, 8, 0.75});
+    } else {
+        scenarios.push_back({6, 11, 8, 0.5});
+        scenarios.push_back({6, 11, 8, 0.75});
+        scenarios.push_back({6, 11, 8, 0.9});
+        scenarios.push_back({10, 20, 8, 0.75});
+        scenarios.push_back({16, 30, 6, 0.75});
+    }
+
+    std::cout << "--- Native Benchmark Suite (seed " << BENCH_SEED << ", " << MISSION_COUNT << " targets"
+              << (quick ? ", quick" : "") << ") ---" << std::endl;
+    BenchmarkRunner bench;
+    MakespanSolver solver(benchConfig(LAYER_BEAM_WIDTH));
+    for (const auto& sc : scenarios) {
+        Instance inst;
+        if (!buildInstance(sc, solver, inst)) {
+            std::cerr << "Cannot generate " << sc.rows << "x" << sc.bays << "x" << sc.levels << " yard" << std::endl;
+            continue;
+        }
+        runMicro(bench, sc, inst, solver);
+        runMacro(bench, sc, inst, quick);
+    }
+
+    if (!jsonPath.empty()) {
+        if (!writeJson(jsonPath, bench.results, quick)) { std::cerr << "Cannot write " << jsonPath << std::endl; return 1; }
+        std::cout << "Results written to " << jsonPath << std::endl;
+    }
+    if (!csvPath.empty()) {
+        if (!writeCsv(csvPath, bench.results)) { std::cerr << "Cannot write " << csvPath << std::endl; return 1; }
+        std::cout << "Results written to " << csvPath << std::endl;
+    }
+    return 0;
+}
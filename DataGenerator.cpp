@@ -6,19 +6,10 @@
 #include <algorithm>
 #include <ctime>
 #include <cstdlib> // For std::atoi
+#include <cstring>
 
-// Define box structure
-struct BoxData {
-    int id;       // Represents parent_carrier_id
-    int row;
-    int bay;
-    int level;
-};
-
-// Define default time constants
-const double DEFAULT_TIME_TRAVEL_UNIT = 5.0; // Seconds per grid unit
-const double DEFAULT_TIME_HANDLE = 30.0;     // Seconds for pickup/dropoff
-const double DEFAULT_TIME_PROCESS = 10.0;    // Seconds for workstation processing
+#include "DataGenerator.h"
+#include "InstanceFile.h"
 
 int main(int argc, char* argv[]) {
     // 1. Set default parameters
@@ -27,8 +18,17 @@ int main(int argc, char* argv[]) {
     int max_level = 8;
     int total_boxes = 400;
     int mission_count = 50;
+    std::string binaryFile; // --binary FILE: also write the instance as a .brp file (InstanceFile.h)
 
     // 2. Process command-line arguments
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--binary") == 0 && i + 1 < argc) {
+            binaryFile = argv[i + 1];
+            for (int j = i; j + 2 <= argc; ++j) argv[j] = argv[j + 2];
+            argc -= 2;
+            break;
+        }
+    }
     if (argc == 1) {
         // No arguments provided, use default configuration
         std::cout << "No arguments provided. Using default configuration." << std::endl;
@@ -41,7 +41,7 @@ int main(int argc, char* argv[]) {
         mission_count = std::atoi(argv[5]);
     } else {
         // Incorrect number of arguments, display usage instructions
-        std::cerr << "Usage: " << argv[0] << " <Rows> <Bays> <Levels> <TotalBoxes> <MissionCount>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <Rows> <Bays> <Levels> <TotalBoxes> <MissionCount> [--binary FILE]" << std::endl;
         std::cerr << "Example: " << argv[0] << " 6 11 8 400 50" << std::endl;
         std::cerr << "Or run without arguments to use defaults." << std::endl;
         return 1;
@@ -74,57 +74,14 @@ int main(int argc, char* argv[]) {
 
     // 4. Initialize random number generator and variables
     std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
-    std::uniform_int_distribution<int> distRow(0, max_row - 1);
-    std::uniform_int_distribution<int> distBay(0, max_bay - 1);
-    
-    // [MODIFIED] Removed distPort because we now use dynamic assignment (-1)
-
-    std::vector<int> heights(max_row * max_bay, 0);
-    std::vector<BoxData> allBoxes;
-    allBoxes.reserve(total_boxes);
-
-    // 5. Generate boxes and place them randomly
-    for (int i = 1; i <= total_boxes; ++i) {
-        bool placed = false;
-        // Safety Valve: If random placement takes too long (e.g., 99% density), switch to linear scan
-        int attempts = 0;
-        
-        while (!placed) {
-            int r, b, idx;
-
-            if (attempts < 1000) {
-                // Random position selection
-                r = distRow(rng);
-                b = distBay(rng);
-                idx = r * max_bay + b;
-                attempts++;
-            } else {
-                // Fill Mode (Linear Scan) - Prevent infinite loops
-                bool foundSlot = false;
-                for (int tr = 0; tr < max_row; ++tr) {
-                    for (int tb = 0; tb < max_bay; ++tb) {
-                        int tidx = tr * max_bay + tb;
-                        if (heights[tidx] < max_level) {
-                            r = tr; b = tb; idx = tidx;
-                            foundSlot = true;
-                            break;
-                        }
-                    }
-                    if (foundSlot) break;
-                }
-                if (!foundSlot) {
-                    std::cerr << "Critical Error: Cannot find slot even though capacity check passed." << std::endl;
-                    return 1;
-                }
-            }
-
-            if (heights[idx] < max_level) {
-                allBoxes.push_back({i, r, b, heights[idx]});
-                heights[idx]++;
-                placed = true;
-            }
-        }
+
+    // 5. Generate boxes and place them randomly, then pick the targets
+    GeneratedYard generated;
+    if (!generateYard(max_row, max_bay, max_level, total_boxes, mission_count, rng, generated)) {
+        std::cerr << "Critical Error: Cannot find slot even though capacity check passed." << std::endl;
+        return 1;
     }
+    const std::vector<BoxData>& allBoxes = generated.boxes;
 
     // 6. Output File A: Inventory Snapshot (mock_yard.csv)
     std::ofstream yardFile("mock_yard.csv");
@@ -140,15 +97,11 @@ int main(int argc, char* argv[]) {
             << "src_row,src_bay,src_level,"
             << "dest_row,dest_bay,dest_level,create_time\n";
 
-    // Randomly select targets
-    std::vector<BoxData> candidates = allBoxes;
-    std::shuffle(candidates.begin(), candidates.end(), rng);
-
     int serialNo = 1;
     long long baseTime = 1705363200; 
 
     for (int i = 0; i < mission_count; ++i) {
-        const auto& box = candidates[i];
+        const auto& box = generated.targets[i];
         
         // [MODIFIED] Destination is now unified to (-1, -1, -1) for Dynamic Port Selection
         cmdFile << serialNo << ","                  // cmd_no
@@ -184,5 +137,34 @@ int main(int argc, char* argv[]) {
               << "2. mock_commands.csv (Missions with Dynamic Port Destination -1)\n"
               << "3. yard_config.csv (Dimensions & Time Params)" << std::endl;
 
+    // 9. Optional Output: Binary Instance (same data as the three CSVs)
+    if (!binaryFile.empty()) {
+        YardInstance instance;
+        instance.config = {max_row, max_bay, max_level, total_boxes,
+                           DEFAULT_TIME_TRAVEL_UNIT, DEFAULT_TIME_HANDLE, DEFAULT_TIME_PROCESS};
+        instance.yard = YardSystem(max_row, max_bay, max_level, total_boxes);
+        for (const auto& box : allBoxes) instance.yard.initBox(box.id, box.row, box.bay, box.level);
+        for (int i = 0; i < mission_count; ++i) {
+            const auto& box = generated.targets[i];
+            Command cmd;
+            cmd.cmd_no = i + 1;
+            cmd.batch_id = 20260117;
+            cmd.cmd_type = "target";
+            cmd.cmd_priority = i + 1;
+            cmd.parent_carrier_id = box.id;
+            cmd.source_position = {box.row, box.bay, box.level};
+            cmd.dest_position = {-1, -1, -1};
+            cmd.create_time = baseTime + (i + 1) * 60;
+            instance.commands.push_back(cmd);
+        }
+
+        std::string error;
+        if (!InstanceFile::write(binaryFile, instance, error)) {
+            std::cerr << "Error: " << error << std::endl;
+            return 1;
+        }
+        std::cout << "4. " << binaryFile << " (Binary Instance)" << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef DATAGENERATOR_H
+#define DATAGENERATOR_H
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// Define box structure
+struct BoxData {
+    int id;       // Represents parent_carrier_id
+    int row;
+    int bay;
+    int level;
+};
+
+// Define default time constants
+const double DEFAULT_TIME_TRAVEL_UNIT = 5.0; // Seconds per grid unit
+const double DEFAULT_TIME_HANDLE = 30.0;     // Seconds for pickup/dropoff
+const double DEFAULT_TIME_PROCESS = 10.0;    // Seconds for workstation processing
+
+// Random yard instance (used by DataGenerator.cpp to write the CSVs, and by Benchmark.cpp)
+struct GeneratedYard {
+    std::vector<BoxData> boxes;    // Boxes 1..total_boxes, stacked bottom-up
+    std::vector<BoxData> targets;  // Retrieval commands, in command order
+};
+
+// Place total_boxes boxes on random columns and pick mission_count of them as targets.
+// Requires total_boxes <= capacity and mission_count <= total_boxes; returns false if a
+// box cannot be placed.
+inline bool generateYard(int max_row, int max_bay, int max_level, int total_boxes, int mission_count,
+                         std::mt19937& rng, GeneratedYard& out) {
+    std::uniform_int_distribution<int> distRow(0, max_row - 1);
+    std::uniform_int_distribution<int> distBay(0, max_bay - 1);
+
+    std::vector<int> heights(max_row * max_bay, 0);
+    out.boxes.clear();
+    out.boxes.reserve(total_boxes);
+
+    // Generate boxes and place them randomly
+    for (int i = 1; i <= total_boxes; ++i) {
+        bool placed = false;
+        // Safety Valve: If random placement takes too long (e.g., 99% density), switch to linear scan
+        int attempts = 0;
+
+        while (!placed) {
+            int r, b, idx;
+
+            if (attempts < 1000) {
+                // Random position selection
+                r = distRow(rng);
+                b = distBay(rng);
+                idx = r * max_bay + b;
+                attempts++;
+            } else {
+                // Fill Mode (Linear Scan) - Prevent infinite loops
+                bool foundSlot = false;
+                for (int tr = 0; tr < max_row; ++tr) {
+                    for (int tb = 0; tb < max_bay; ++tb) {
+                        int tidx = tr * max_bay + tb;
+                        if (heights[tidx] < max_level) {
+                            r = tr; b = tb; idx = tidx;
+                            foundSlot = true;
+                            break;
+                        }
+                    }
+                    if (foundSlot) break;
+                }
+                if (!foundSlot) return false;
+            }
+
+            if (heights[idx] < max_level) {
+                out.boxes.push_back({i, r, b, heights[idx]});
+                heights[idx]++;
+                placed = true;
+            }
+        }
+    }
+
+    // Randomly select targets
+    std::vector<BoxData> candidates = out.boxes;
+    std::shuffle(candidates.begin(), candidates.end(), rng);
+    out.targets.assign(candidates.begin(), candidates.begin() + mission_count);
+    return true;
+}
+
+#endif // DATAGENERATOR_H
@@ -3,9 +3,29 @@
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <iterator>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define DATALOADER_MMAP 1
+#endif
+
+// ==========================================
+// CSV Loader
+// Each file is mapped into memory (POSIX mmap, otherwise read in one go) and parsed in a
+// single pass: rows are counted first so the result is reserved once, then every field is
+// parsed in place (no per-line strings, no streams, no exceptions).
+// Malformed rows are skipped and reported with their line number, either into a
+// LoadReport or, without one, on std::cerr.
+// ==========================================
 
 // 1. Coordinate Structure
 struct Coord3D {
@@ -40,116 +60,395 @@ struct YardConfig {
     int max_bay;
     int max_level;
     int total_boxes;
+    double time_travel_unit;  // optional columns (README §2.1 defaults when absent)
+    double time_handle;
+    double time_process;
+};
+
+// 5. Parse Diagnostics
+struct ParseError {
+    int line;             // 1-based line number in the file
+    std::string message;
+};
+
+struct LoadReport {
+    std::string filename;
+    bool opened;
+    size_t rowsRead;                  // rows returned
+    std::vector<ParseError> errors;   // rows skipped (or config fields rejected)
+
+    LoadReport() : opened(false), rowsRead(0) {}
+};
+
+// Read-only view of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename) : data(nullptr), length(0), opened(false), mapped(false) {
+#ifdef DATALOADER_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0) {
+            opened = true;
+            length = (size_t)st.st_size;
+            if (length > 0) {
+                void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    data = static_cast<const char*>(p);
+                    mapped = true;
+                } else {
+                    opened = false;
+                    length = 0;
+                }
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return;
+        opened = true;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        length = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef DATALOADER_MMAP
+        if (mapped) ::munmap(const_cast<char*>(data), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+
+private:
+    const char* data;
+    size_t length;
+    bool opened;
+    bool mapped;
+#ifndef DATALOADER_MMAP
+    std::string buffer;
+#endif
+};
+
+// Comma-separated fields of one line, parsed in place
+class CsvRow {
+public:
+    CsvRow(const char* first, const char* last)
+        : cur(first), end(last), fieldFirst(first), fieldLast(first), index(0), done(false), missing(false) {}
+
+    // Next field as [first, last); false once the row has no more fields
+    bool next(const char*& first, const char*& last) {
+        if (done) {
+            missing = true;
+            return false;
+        }
+        first = cur;
+        const char* comma = static_cast<const char*>(std::memchr(cur, ',', (size_t)(end - cur)));
+        if (comma) {
+            last = comma;
+            cur = comma + 1;
+        } else {
+            last = end;
+            done = true;
+        }
+        index++;
+        fieldFirst = first;
+        fieldLast = last;
+        return true;
+    }
+
+    // Integer in [min, max], surrounding blanks allowed (from_chars-style: no locale, no allocation)
+    static bool parseInteger(const char* first, const char* last, long long minValue, long long maxValue, long long& value) {
+        trim(first, last);
+        if (first == last) return false;
+        bool negative = false;
+        if (*first == '-' || *first == '+') {
+            negative = (*first == '-');
+            if (++first == last) return false;
+        }
+        unsigned long long magnitude = 0;
+        for (; first != last; ++first) {
+            unsigned digit = (unsigned)(*first - '0');
+            if (digit > 9) return false;
+            if (magnitude > (ULLONG_MAX - digit) / 10) return false;
+            magnitude = magnitude * 10 + digit;
+        }
+        if (negative ? magnitude > (unsigned long long)LLONG_MAX + 1 : magnitude > (unsigned long long)LLONG_MAX) return false;
+        value = negative ? (long long)(0 - magnitude) : (long long)magnitude;
+        return value >= minValue && value <= maxValue;
+    }
+
+    static bool parseDouble(const char* first, const char* last, double& value) {
+        trim(first, last);
+        if (first == last || last - first > 63) return false;
+        char text[64];
+        std::memcpy(text, first, (size_t)(last - first));
+        text[last - first] = '\0';
+        char* parsedEnd = nullptr;
+        value = std::strtod(text, &parsedEnd);
+        return parsedEnd == text + (last - first);
+    }
+
+    static void trim(const char*& first, const char*& last) {
+        while (first != last && (*first == ' ' || *first == '\t')) ++first;
+        while (last != first && (last[-1] == ' ' || last[-1] == '\t')) --last;
+    }
+
+    bool nextInt(int& value) {
+        const char *first, *last;
+        long long v;
+        if (!next(first, last) || !parseInteger(first, last, INT_MIN, INT_MAX, v)) return false;
+        value = (int)v;
+        return true;
+    }
+
+    bool nextLong(long long& value) {
+        const char *first, *last;
+        return next(first, last) && parseInteger(first, last, LLONG_MIN, LLONG_MAX, value);
+    }
+
+    bool nextString(std::string& value) {
+        const char *first, *last;
+        if (!next(first, last)) return false;
+        trim(first, last);
+        value.assign(first, last);
+        return true;
+    }
+
+    // Where the last read failed: 1-based field index, and whether that field was missing altogether
+    int failedField() const { return missing ? index + 1 : index; }
+    bool fieldMissing() const { return missing; }
+    int fieldIndex() const { return index; }  // 1-based index of the last field read
+    std::string lastField() const { return std::string(fieldFirst, fieldLast); }
+
+private:
+    const char* cur;
+    const char* end;
+    const char* fieldFirst;
+    const char* fieldLast;
+    int index;
+    bool done;
+    bool missing;
 };
 
 class DataLoader {
 public:
-    // Load Yard Snapshot (mock_yard.csv)
-    static std::vector<BoxSnapshot> loadYardSnapshot(const std::string& filename) {
+    // Load Yard Snapshot (mock_yard.csv): container_id,row,bay,level
+    static std::vector<BoxSnapshot> loadYardSnapshot(const std::string& filename, LoadReport* report = nullptr) {
+        static const char* fields[] = {"container_id", "row", "bay", "level"};
         std::vector<BoxSnapshot> boxes;
-        std::ifstream file(filename);
-        std::string line;
-        
-        // Skip Header
-        std::getline(file, line); 
-
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            std::stringstream ss(line);
-            std::string segment;
-            BoxSnapshot box;
+        LoadReport local;
+        LoadReport& rep = report ? *report : local;
+        rep = LoadReport();
+        rep.filename = filename;
 
-            std::getline(ss, segment, ','); box.container_id = std::stoi(segment);
-            std::getline(ss, segment, ','); box.row = std::stoi(segment);
-            std::getline(ss, segment, ','); box.bay = std::stoi(segment);
-            std::getline(ss, segment, ','); box.level = std::stoi(segment);
+        MappedFile file(filename);
+        if (!file.isOpen()) return boxes;
+        rep.opened = true;
+        boxes.reserve(countRows(file));
 
+        forEachRow(file, [&](CsvRow& row, int lineNo) {
+            BoxSnapshot box;
+            if (!row.nextInt(box.container_id) || !row.nextInt(box.row) || !row.nextInt(box.bay) || !row.nextInt(box.level)) {
+                addFieldError(rep, lineNo, row, fields, 4, "an integer");
+                return;
+            }
             boxes.push_back(box);
-        }
+        });
+
+        rep.rowsRead = boxes.size();
+        if (!report) printErrors(rep);
         return boxes;
     }
 
-    // Load Commands (mock_commands.csv)
-    static std::vector<Command> loadCommands(const std::string& filename) {
+    // Load Commands (mock_commands.csv):
+    // cmd_no,batch_id,cmd_type,cmd_priority,parent_carrier_id,src_row,src_bay,src_level,dest_row,dest_bay,dest_level,create_time
+    static std::vector<Command> loadCommands(const std::string& filename, LoadReport* report = nullptr) {
+        static const char* fields[] = {"cmd_no", "batch_id", "cmd_type", "cmd_priority", "parent_carrier_id",
+                                       "src_row", "src_bay", "src_level"};
         std::vector<Command> commands;
-        std::ifstream file(filename);
-        std::string line;
+        LoadReport local;
+        LoadReport& rep = report ? *report : local;
+        rep = LoadReport();
+        rep.filename = filename;
 
-        // Skip Header
-        std::getline(file, line);
+        MappedFile file(filename);
+        if (!file.isOpen()) return commands;
+        rep.opened = true;
+        commands.reserve(countRows(file));
 
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            std::stringstream ss(line);
-            std::string segment;
+        forEachRow(file, [&](CsvRow& row, int lineNo) {
             Command cmd;
+            // 1-6. cmd_no, batch_id, cmd_type, cmd_priority, parent_carrier_id, source_position (x, y, z)
+            if (!row.nextInt(cmd.cmd_no) || !row.nextInt(cmd.batch_id) || !row.nextString(cmd.cmd_type)
+                || !row.nextInt(cmd.cmd_priority) || !row.nextInt(cmd.parent_carrier_id)
+                || !row.nextInt(cmd.source_position.row) || !row.nextInt(cmd.source_position.bay)
+                || !row.nextInt(cmd.source_position.level)) {
+                addFieldError(rep, lineNo, row, fields, 8, "an integer");
+                return;
+            }
 
-            // 1. cmd_no
-            std::getline(ss, segment, ','); cmd.cmd_no = std::stoi(segment);
-            
-            // 2. batch_id
-            std::getline(ss, segment, ','); cmd.batch_id = std::stoi(segment);
-            
-            // 3. cmd_type
-            std::getline(ss, cmd.cmd_type, ',');
-            
-            // 4. cmd_priority
-            std::getline(ss, segment, ','); cmd.cmd_priority = std::stoi(segment);
-            
-            // 5. parent_carrier_id
-            std::getline(ss, segment, ','); cmd.parent_carrier_id = std::stoi(segment);
-            
-            // 6. source_position (x, y, z)
-            std::getline(ss, segment, ','); cmd.source_position.row = std::stoi(segment);
-            std::getline(ss, segment, ','); cmd.source_position.bay = std::stoi(segment);
-            std::getline(ss, segment, ','); cmd.source_position.level = std::stoi(segment);
-
-            // 7. dest_position (x, y, z)
-            try {
-                std::getline(ss, segment, ','); cmd.dest_position.row = std::stoi(segment);
-                std::getline(ss, segment, ','); cmd.dest_position.bay = std::stoi(segment);
-                std::getline(ss, segment, ','); cmd.dest_position.level = std::stoi(segment);
-            } catch (...) {
+            // 7. dest_position (x, y, z): optional, a workstation / dynamic port is (-1, -1, -1)
+            if (!row.nextInt(cmd.dest_position.row) || !row.nextInt(cmd.dest_position.bay) || !row.nextInt(cmd.dest_position.level)) {
                 cmd.dest_position = {-1, -1, -1};
+                if (row.fieldIndex() < 11) {
+                    // Skip what is left of the destination so create_time stays the 12th field
+                    const char *first, *last;
+                    while (row.fieldIndex() < 11 && row.next(first, last)) {}
+                }
             }
 
-            // 8. create_time
-            std::getline(ss, segment, ','); 
-            if (!segment.empty()) cmd.create_time = std::stoll(segment);
-            else cmd.create_time = 0;
-
+            // 8. create_time: optional (empty = 0)
+            const char *first, *last;
+            cmd.create_time = 0;
+            if (row.next(first, last)) {
+                CsvRow::trim(first, last);
+                if (first != last && !CsvRow::parseInteger(first, last, LLONG_MIN, LLONG_MAX, cmd.create_time)) {
+                    rep.errors.push_back({lineNo, "field 12 (create_time): expected an integer, got '" + std::string(first, last) + "'"});
+                    return;
+                }
+            }
             commands.push_back(cmd);
-        }
+        });
+
+        rep.rowsRead = commands.size();
+        if (!report) printErrors(rep);
         return commands;
     }
 
-    // Load Yard Configuration (yard_config.csv)
-    static YardConfig loadYardConfig(const std::string& filename) {
-        std::ifstream file(filename);
-        YardConfig config = {0, 0, 0, 0}; // Default failure value
-        
-        if (!file.is_open()) return config;
-
-        std::string line;
-        // Skip Header
-        std::getline(file, line);
-        
-        // Read Data
-        if (std::getline(file, line)) {
-            std::stringstream ss(line);
-            std::string segment;
-            
-            try {
-                std::getline(ss, segment, ','); config.max_row = std::stoi(segment);
-                std::getline(ss, segment, ','); config.max_bay = std::stoi(segment);
-                std::getline(ss, segment, ','); config.max_level = std::stoi(segment);
-                std::getline(ss, segment, ','); config.total_boxes = std::stoi(segment);
-            } catch (...) {
-                // Parse error, return default 0s
+    // Load Yard Configuration (yard_config.csv), columns matched by header name.
+    // max_row / max_bay / max_level / total_boxes are required (max_row == 0 signals failure);
+    // time_travel_unit / time_handle / time_process default to README §2.1 when absent.
+    static YardConfig loadYardConfig(const std::string& filename, LoadReport* report = nullptr) {
+        YardConfig config = {0, 0, 0, 0, 5.0, 30.0, 10.0}; // Default failure value
+        LoadReport local;
+        LoadReport& rep = report ? *report : local;
+        rep = LoadReport();
+        rep.filename = filename;
+
+        MappedFile file(filename);
+        if (!file.isOpen()) return config;
+        rep.opened = true;
+
+        std::vector<std::string> header;
+        bool haveData = false;
+        YardConfig parsed = config;
+        const char* p = file.begin();
+        int lineNo = 0;
+        while (p < file.end() && !haveData) {
+            const char* lineStart = p;
+            const char* lineEnd = lineEndOf(p, file.end());
+            p = lineEnd < file.end() ? lineEnd + 1 : file.end();
+            lineNo++;
+            if (lineEnd > lineStart && lineEnd[-1] == '\r') --lineEnd;
+            CsvRow row(lineStart, lineEnd);
+            if (lineNo == 1) {
+                std::string name;
+                while (row.nextString(name)) header.push_back(name);
+                continue;
+            }
+            if (lineEnd == lineStart) continue;
+
+            haveData = true;
+            bool ok = true;
+            int required = 0;
+            const char *first, *last;
+            for (size_t col = 0; row.next(first, last); ++col) {
+                if (col >= header.size()) break;
+                const std::string& name = header[col];
+                int* intField = name == "max_row" ? &parsed.max_row : name == "max_bay" ? &parsed.max_bay
+                              : name == "max_level" ? &parsed.max_level : name == "total_boxes" ? &parsed.total_boxes : nullptr;
+                double* timeField = name == "time_travel_unit" ? &parsed.time_travel_unit : name == "time_handle" ? &parsed.time_handle
+                                  : name == "time_process" ? &parsed.time_process : nullptr;
+                long long v;
+                if (intField) {
+                    if (!CsvRow::parseInteger(first, last, 1, INT_MAX, v)) {
+                        rep.errors.push_back({lineNo, "field " + std::to_string(col + 1) + " (" + name + "): expected a positive integer, got '"
+                                                      + std::string(first, last) + "'"});
+                        ok = false;
+                    } else {
+                        *intField = (int)v;
+                        required++;
+                    }
+                } else if (timeField && !CsvRow::parseDouble(first, last, *timeField)) {
+                    rep.errors.push_back({lineNo, "field " + std::to_string(col + 1) + " (" + name + "): expected a number, got '"
+                                                  + std::string(first, last) + "'"});
+                    ok = false;
+                }
+            }
+            if (ok && required < 4) {
+                rep.errors.push_back({lineNo, "missing one of max_row, max_bay, max_level, total_boxes"});
+                ok = false;
+            }
+            if (ok) {
+                config = parsed;
+                rep.rowsRead = 1;
             }
         }
+
+        if (!report) printErrors(rep);
         return config;
     }
+
+    // "file:line: message" for every rejected row (at most maxLines, then a count)
+    static void printErrors(const LoadReport& report, size_t maxLines = 10) {
+        for (size_t i = 0; i < report.errors.size() && i < maxLines; ++i) {
+            std::cerr << report.filename << ":" << report.errors[i].line << ": " << report.errors[i].message << std::endl;
+        }
+        if (report.errors.size() > maxLines) {
+            std::cerr << report.filename << ": " << report.errors.size() - maxLines << " more malformed rows" << std::endl;
+        }
+    }
+
+    // --- Row helpers, shared with the other CSV readers (MissionSimulator::loadMissions) ---
+
+    // Upper bound on the data rows (newlines + a possibly unterminated last line)
+    static size_t countRows(const MappedFile& file) {
+        size_t lines = 0;
+        for (const char* p = file.begin(); p < file.end(); p = lineEndOf(p, file.end()) + 1) lines++;
+        return lines > 0 ? lines - 1 : 0;
+    }
+
+    // Calls fn(row, lineNo) for every non-empty line after the header
+    template <typename Fn>
+    static void forEachRow(const MappedFile& file, Fn fn) {
+        const char* p = file.begin();
+        const char* end = file.end();
+        int lineNo = 0;
+        while (p < end) {
+            const char* lineEnd = lineEndOf(p, end);
+            const char* next = lineEnd < end ? lineEnd + 1 : end;
+            lineNo++;
+            if (lineEnd > p && lineEnd[-1] == '\r') --lineEnd;
+            if (lineNo > 1 && lineEnd != p) {
+                CsvRow row(p, lineEnd);
+                fn(row, lineNo);
+            }
+            p = next;
+        }
+    }
+
+    // e.g. "field 2 (row): expected an integer, got 'x'" / "field 4 (level): missing"
+    static void addFieldError(LoadReport& rep, int lineNo, const CsvRow& row, const char* const* names, int nameCount, const char* expected) {
+        int field = row.failedField();
+        std::string message = "field " + std::to_string(field);
+        if (field >= 1 && field <= nameCount) message += std::string(" (") + names[field - 1] + ")";
+        if (row.fieldMissing()) message += ": missing";
+        else message += std::string(": expected ") + expected + ", got '" + row.lastField() + "'";
+        rep.errors.push_back({lineNo, message});
+    }
+
+private:
+    static const char* lineEndOf(const char* p, const char* end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+        return nl ? nl : end;
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
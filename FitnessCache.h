@@ -0,0 +1,102 @@
+#ifndef FITNESSCACHE_H
+#define FITNESSCACHE_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+// ==========================================
+// Sequence -> Fitness Memo Cache (shared across GA generations)
+// A value computed from scratch is exact. A value from a resumed evaluation (PrefixCheckpoint.h)
+// is approximate: the resumed prefix was scored with another sequence's later ranks. Each entry
+// keeps that flag, and an exact value for the same sequence replaces an approximate one.
+// The GA only inserts at the generation barrier, so the cache content does not depend on threads.
+// Entries are spread over independently locked shards; each shard keeps at most
+// capacity / SHARD_COUNT entries and evicts its oldest one first (FIFO).
+// ==========================================
+class FitnessCache {
+public:
+    // capacity == 0 disables the cache (every lookup is a miss, nothing is stored)
+    explicit FitnessCache(size_t capacity)
+        : shardCapacity((capacity + SHARD_COUNT - 1) / SHARD_COUNT) {}
+
+    FitnessCache(const FitnessCache&) = delete;
+    FitnessCache& operator=(const FitnessCache&) = delete;
+
+    bool lookup(const std::vector<int>& sequence, double& fitness, bool& exact) {
+        if (shardCapacity > 0) {
+            unsigned long long key = hashSequence(sequence);
+            Shard& shard = shards[key % SHARD_COUNT];
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end() && it->second.sequence == sequence) {
+                fitness = it->second.fitness;
+                exact = it->second.exact;
+                hitCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void insert(const std::vector<int>& sequence, double fitness, bool exact) {
+        if (shardCapacity == 0) return;
+        unsigned long long key = hashSequence(sequence);
+        Shard& shard = shards[key % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            // Already cached (or a hash collision: keep the first); an exact value upgrades an approximate one
+            if (exact && !it->second.exact && it->second.sequence == sequence) {
+                it->second.fitness = fitness;
+                it->second.exact = true;
+            }
+            return;
+        }
+
+        if (shard.order.size() >= shardCapacity) {
+            shard.entries.erase(shard.order.front());
+            shard.order.pop_front();
+        }
+        shard.entries[key] = {sequence, fitness, exact};
+        shard.order.push_back(key);
+    }
+
+    long long hits() const { return hitCount.load(); }
+    long long misses() const { return missCount.load(); }
+
+    static unsigned long long hashSequence(const std::vector<int>& sequence) {
+        unsigned long long h = 1469598103934665603ULL ^ sequence.size();
+        for (int id : sequence) {
+            h ^= (unsigned long long)(unsigned int)id;
+            h *= 1099511628211ULL;
+            h ^= h >> 29;
+        }
+        return h;
+    }
+
+private:
+    static const size_t SHARD_COUNT = 16;
+
+    struct Entry {
+        std::vector<int> sequence; // Stored to rule out hash collisions
+        double fitness;
+        bool exact;                // false: from a resumed evaluation
+    };
+
+    struct Shard {
+        std::mutex mtx;
+        std::unordered_map<unsigned long long, Entry> entries;
+        std::deque<unsigned long long> order; // Insertion order, for eviction
+    };
+
+    size_t shardCapacity;
+    Shard shards[SHARD_COUNT];
+    std::atomic<long long> hitCount{0};
+    std::atomic<long long> missCount{0};
+};
+
+#endif // FITNESSCACHE_H
@@ -0,0 +1,357 @@
+#ifndef GENETICALGORITHM_H
+#define GENETICALGORITHM_H
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <functional>
+
+#include "ThreadPool.h"
+#include "FitnessCache.h"
+#include "PrefixCheckpoint.h"
+
+// ==========================================
+// GA Module (target sequence optimization)
+// The fitness is supplied by an Objective, so the same GA drives the reshuffle-count
+// evaluator of main.cpp and the multi-AGV makespan solver (MakespanSolver.h):
+//   typedef ... State;   // beam state kept in prefix checkpoints
+//   double evaluate(const std::vector<int>& seq) const;   // exact, lower is better
+//   double evaluateResumable(const std::vector<int>& seq, PrefixCheckpointStore<State>& store,
+//                            std::vector<PrefixCheckpointStore<State>::Checkpoint>& saved,
+//                            bool& resumed) const;           // approximate when resumed
+// Both evaluate calls run concurrently on the worker pool.
+// ==========================================
+
+struct GAConfig {
+    int populationSize;
+    int maxGenerations;
+    double mutationRate;
+    double crossoverRate;     // chance that a child is built with Order Crossover (OX)
+    int islandCount;          // sub-populations (populationSize is split between them)
+    int migrationInterval;    // generations between migrations
+    int migrantCount;         // best individuals sent to the next island (ring)
+    int workers;              // fitness threads (0 = all hardware threads)
+    size_t fitnessCacheSize;  // max cached sequences (0 = no cache)
+    size_t checkpointBudgetMB; // memory for prefix checkpoints (0 = always evaluate from scratch)
+    bool verbose;             // print the best individual every 10 generations
+
+    GAConfig()
+        : populationSize(50), maxGenerations(30), mutationRate(0.2), crossoverRate(0.7), islandCount(1),
+          migrationInterval(5), migrantCount(2), workers(0), fitnessCacheSize(1 << 14), checkpointBudgetMB(32),
+          verbose(true) {}
+};
+
+// Progress report of one GA generation
+struct GAProgress {
+    int generation;
+    double elapsedSec;
+    double bestCost;     // Best fitness so far (exact)
+    double evalsPerSec;  // Beam evaluations per second (cache hits excluded)
+};
+typedef std::function<bool(const GAProgress&)> ProgressCallback;
+
+template <typename Objective>
+class GeneticAlgorithm {
+    typedef PrefixCheckpointStore<typename Objective::State> CheckpointStore;
+    typedef typename CheckpointStore::Checkpoint Checkpoint;
+
+    struct Individual {
+        std::vector<int> sequence;
+        double fitness;
+        bool exact;  // false: fitness comes from a resumed (approximate) evaluation
+    };
+
+    static double unevaluated() { return std::numeric_limits<double>::infinity(); }
+
+    // Island Model: an independent sub-population with its own RNG and memo stores,
+    // so islands never share mutable state while they evolve in parallel
+    struct Island {
+        std::vector<Individual> population;
+        std::mt19937 rng;
+        FitnessCache cache;
+        CheckpointStore checkpoints;
+        long long evaluations = 0; // Beam evaluations run in the last generation
+
+        Island(unsigned int seed, int index, size_t cacheSize, size_t checkpointBudget)
+            : cache(cacheSize), checkpoints(checkpointBudget) {
+            std::seed_seq seq{seed, (unsigned int)index};
+            rng.seed(seq);
+        }
+    };
+
+    const Objective& objective;
+    GAConfig config;
+    std::vector<std::unique_ptr<Island>> islands;
+    ThreadPool pool;
+    Individual best;
+    double timeBudget = 0;     // seconds, 0 = run maxGenerations
+    ProgressCallback progress;
+    int maxBoxId;
+
+    static bool byFitness(const Individual& a, const Individual& b) { return a.fitness < b.fitness; }
+
+    // Calculate Fitness of every new individual of one island, then sort it.
+    // parallel: spread the evaluations over the pool (only when islands are not already parallel).
+    // Workers only read the cache / checkpoint store; new entries are published after the
+    // barrier in index order, so a fixed seed gives the same run.
+    // Resumed scores are approximate and are ranked as they are, except for the island leader:
+    // it drives elitism, migration and the reported best, so it is re-scored from scratch
+    // until the leader's fitness is exact
+    void evaluateIsland(Island& island, bool parallel) {
+        std::vector<Individual>& population = island.population;
+        std::vector<int> pending;
+        for (int i = 0; i < (int)population.size(); ++i) {
+            if (population[i].fitness == unevaluated()) pending.push_back(i);
+        }
+
+        std::vector<char> evaluated(pending.size(), 0);
+        std::vector<std::vector<Checkpoint>> saved(pending.size());
+        auto job = [&](int k) {
+            Individual& ind = population[pending[k]];
+            if (island.cache.lookup(ind.sequence, ind.fitness, ind.exact)) return;
+            bool resumed = false;
+            ind.fitness = objective.evaluateResumable(ind.sequence, island.checkpoints, saved[k], resumed);
+            ind.exact = !resumed;
+            evaluated[k] = 1;
+        };
+        if (parallel) pool.parallelFor((int)pending.size(), job);
+        else for (int k = 0; k < (int)pending.size(); ++k) job(k);
+
+        island.evaluations = 0;
+        for (size_t k = 0; k < pending.size(); ++k) {
+            if (!evaluated[k]) continue;
+            island.evaluations++;
+            const Individual& ind = population[pending[k]];
+            island.cache.insert(ind.sequence, ind.fitness, ind.exact);
+            for (auto& cp : saved[k]) island.checkpoints.insert(std::move(cp));
+        }
+
+        std::sort(population.begin(), population.end(), byFitness);
+        while (!population[0].exact) {
+            Individual& leader = population[0];
+            leader.fitness = objective.evaluate(leader.sequence);
+            leader.exact = true;
+            island.evaluations++;
+            island.cache.insert(leader.sequence, leader.fitness, true);
+            std::sort(population.begin(), population.end(), byFitness);
+        }
+    }
+
+    // Order Crossover (OX): keep p1's slice [cut1, cut2], fill the other positions with the
+    // remaining targets in the order they appear in p2 (starting after the slice)
+    std::vector<int> orderCrossover(const std::vector<int>& p1, const std::vector<int>& p2, std::mt19937& rng) const {
+        int n = (int)p1.size();
+        int cut1 = std::uniform_int_distribution<int>(0, n - 1)(rng);
+        int cut2 = std::uniform_int_distribution<int>(0, n - 1)(rng);
+        if (cut1 > cut2) std::swap(cut1, cut2);
+
+        std::vector<int> child(n);
+        std::vector<char> used(maxBoxId + 1, 0);
+        for (int i = cut1; i <= cut2; ++i) {
+            child[i] = p1[i];
+            used[p1[i]] = 1;
+        }
+
+        int pos = (cut2 + 1) % n;
+        for (int k = 0; k < n; ++k) {
+            int id = p2[(cut2 + 1 + k) % n];
+            if (used[id]) continue;
+            child[pos] = id;
+            pos = (pos + 1) % n;
+        }
+        return child;
+    }
+
+    // Evolution of one (sorted) island: elitism, selection, OX crossover, swap mutation
+    void evolveIsland(Island& island) {
+        std::vector<Individual>& population = island.population;
+        std::mt19937& rng = island.rng;
+        int size = (int)population.size();
+
+        std::vector<Individual> nextGen;
+        int eliteCount = size * 0.1;
+        if (eliteCount < 1) eliteCount = 1;
+        for(int i=0; i<eliteCount; ++i) nextGen.push_back(population[i]); // Elitism
+
+        while((int)nextGen.size() < size) {
+            // Tournament Selection
+            const auto& p1 = population[std::uniform_int_distribution<int>(0, size/2)(rng)];
+            Individual child = p1;
+
+            // Crossover
+            if(std::uniform_real_distribution<double>(0,1)(rng) < config.crossoverRate) {
+                const auto& p2 = population[std::uniform_int_distribution<int>(0, size/2)(rng)];
+                child.sequence = orderCrossover(p1.sequence, p2.sequence, rng);
+                child.fitness = unevaluated();
+            }
+
+            // Mutation
+            if(std::uniform_real_distribution<double>(0,1)(rng) < config.mutationRate) {
+                int idx1 = std::uniform_int_distribution<int>(0, child.sequence.size()-1)(rng);
+                int idx2 = std::uniform_int_distribution<int>(0, child.sequence.size()-1)(rng);
+                std::swap(child.sequence[idx1], child.sequence[idx2]);
+                child.fitness = unevaluated();
+            }
+            nextGen.push_back(child);
+        }
+        population = nextGen;
+    }
+
+    // Ring migration: the best migrantCount of island i replace the worst of island i+1
+    void migrate() {
+        int n = (int)islands.size();
+        std::vector<std::vector<Individual>> migrants(n);
+        for (int i = 0; i < n; ++i) {
+            const auto& pop = islands[i]->population;
+            migrants[i].assign(pop.begin(), pop.begin() + std::min((int)pop.size(), config.migrantCount));
+        }
+        for (int i = 0; i < n; ++i) {
+            auto& dst = islands[(i + 1) % n]->population;
+            for (size_t m = 0; m < migrants[i].size() && m < dst.size(); ++m) dst[dst.size() - 1 - m] = migrants[i][m];
+            std::sort(dst.begin(), dst.end(), byFitness);
+        }
+    }
+
+public:
+    // Each island owns its RNG (seeded from seed + island index) and the RNGs are only used
+    // on one thread at a time, so a fixed seed gives the same result for any worker count
+    // (a resumed score depends on the checkpoints stored so far, and those only change at the
+    // generation barrier, in index order).
+    // The objective must outlive the GA.
+    GeneticAlgorithm(const Objective& fitness, const std::vector<int>& targets, unsigned int seed, const GAConfig& gaConfig)
+        : objective(fitness), config(gaConfig), pool(gaConfig.workers) {
+        if (config.islandCount < 1) config.islandCount = 1;
+        maxBoxId = 0;
+        for (int id : targets) maxBoxId = std::max(maxBoxId, id);
+
+        int islandSize = std::max(2, config.populationSize / config.islandCount);
+        for (int k = 0; k < config.islandCount; ++k) {
+            islands.emplace_back(new Island(seed, k, config.fitnessCacheSize, (config.checkpointBudgetMB << 20) / config.islandCount));
+            Island& island = *islands.back();
+            island.population.resize(islandSize);
+            for (auto& ind : island.population) {
+                ind.sequence = targets;
+                std::shuffle(ind.sequence.begin(), ind.sequence.end(), island.rng);
+                ind.fitness = unevaluated();
+                ind.exact = false;
+            }
+        }
+    }
+
+    // Warm start: the first individuals of every island become `sequences` (permutations of the
+    // targets, e.g. a previous run's population, best first). At most half of an island is seeded,
+    // the random rest keeps it diverse. Call before solve().
+    void seedPopulation(const std::vector<std::vector<int>>& sequences) {
+        for (auto& island : islands) {
+            size_t seeded = std::min(sequences.size(), (island->population.size() + 1) / 2);
+            for (size_t i = 0; i < seeded; ++i) {
+                island->population[i].sequence = sequences[i];
+                island->population[i].fitness = unevaluated();
+                island->population[i].exact = false;
+            }
+        }
+    }
+
+    // Anytime mode: with a budget the GA keeps evolving until the deadline instead of
+    // stopping after maxGenerations; the deadline is checked between generations
+    void setTimeBudget(double seconds) { timeBudget = seconds; }
+
+    // Called after every generation; returning false stops the run with the best so far
+    void setProgressCallback(const ProgressCallback& callback) { progress = callback; }
+
+    void solve() {
+        auto start = std::chrono::steady_clock::now();
+        long long evaluations = 0;
+
+        for (int gen = 0; timeBudget > 0 || gen < config.maxGenerations; ++gen) {
+            // Calculate Fitness: one island -> parallel evaluations, several -> one island per job
+            if (islands.size() == 1) {
+                evaluateIsland(*islands[0], true);
+            } else {
+                pool.parallelFor((int)islands.size(), [&](int k) { evaluateIsland(*islands[k], false); });
+            }
+            for (const auto& island : islands) evaluations += island->evaluations;
+
+            // Best over all islands (lowest index wins ties)
+            best = islands[0]->population[0];
+            for (const auto& island : islands) {
+                if (island->population[0].fitness < best.fitness) best = island->population[0];
+            }
+
+            // Stop conditions: generation limit, time budget, or the caller
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            bool lastGen = (timeBudget > 0) ? elapsed >= timeBudget : gen == config.maxGenerations - 1;
+            if (progress && !progress({gen, elapsed, best.fitness, evaluations / std::max(elapsed, 1e-9)})) lastGen = true;
+
+            if (config.verbose && (gen % 10 == 0 || lastGen)) {
+                std::cout << "Gen " << std::setw(3) << gen << " | Best Cost: " << best.fitness << std::endl;
+                std::cout << " | Seq: [ ";
+                for (size_t i = 0; i < best.sequence.size(); ++i) {
+                    std::cout << best.sequence[i] << (i < best.sequence.size() - 1 ? ", " : "");
+                }
+                std::cout << " ]\n\n";
+            }
+
+            if (lastGen) break;
+            if (islands.size() > 1 && (gen + 1) % config.migrationInterval == 0) migrate();
+
+            // Evolution
+            for (auto& island : islands) evolveIsland(*island);
+        }
+    }
+
+    std::vector<int> getBestSequence() { return best.sequence; }
+
+    // Final population of every island (island order, best first within an island), for seedPopulation()
+    std::vector<std::vector<int>> getPopulation() const {
+        std::vector<std::vector<int>> sequences;
+        for (const auto& island : islands) {
+            for (const auto& ind : island->population) sequences.push_back(ind.sequence);
+        }
+        return sequences;
+    }
+    double getBestFitness() { return best.fitness; }
+    int getWorkerCount() const { return pool.size(); }
+    int getIslandCount() const { return (int)islands.size(); }
+
+    long long getCacheHits() const {
+        long long total = 0;
+        for (const auto& island : islands) total += island->cache.hits();
+        return total;
+    }
+    long long getCacheMisses() const {
+        long long total = 0;
+        for (const auto& island : islands) total += island->cache.misses();
+        return total;
+    }
+    long long getResumeLookups() const {
+        long long total = 0;
+        for (const auto& island : islands) total += island->checkpoints.lookups();
+        return total;
+    }
+    long long getResumedEvaluations() const {
+        long long total = 0;
+        for (const auto& island : islands) total += island->checkpoints.resumed();
+        return total;
+    }
+    double getSkippedTargetRatio() const {
+        long long requested = 0, skipped = 0;
+        for (const auto& island : islands) {
+            requested += island->checkpoints.targetsRequested();
+            skipped += island->checkpoints.targetsSkipped();
+        }
+        return requested ? (double)skipped / requested : 0.0;
+    }
+    size_t getCheckpointMemory() const {
+        size_t total = 0;
+        for (const auto& island : islands) total += island->checkpoints.memoryUsed();
+        return total;
+    }
+};
+
+#endif // GENETICALGORITHM_H
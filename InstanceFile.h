@@ -0,0 +1,276 @@
+#ifndef INSTANCEFILE_H
+#define INSTANCEFILE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+#include "DataLoader.h"
+#include "YardSystem.h"
+
+// ==========================================
+// Binary Instance File (.brp)
+// One file holding what the three CSVs describe (config + time parameters, yard, commands),
+// laid out so loading is a few memcpys from a mapped file instead of text parsing:
+//   [InstanceHeader][tops + grid: R*B + R*B*T int32][boxLocations: 3*BOX_CAPACITY int32]
+//   [InstanceCommandRecord x commandCount]
+// The yard sections are YardSystem's own flat layout; the rank summaries are not stored
+// (they depend on the retrieval sequence and are rebuilt by attachRanks).
+// Native byte order; readers reject files from a different version or byte order.
+// ==========================================
+
+const char INSTANCE_MAGIC[8] = {'B', 'R', 'P', 'I', 'N', 'S', 'T', '\0'};
+const uint32_t INSTANCE_FORMAT_VERSION = 1;
+const uint32_t INSTANCE_ENDIAN_TAG = 0x01020304;
+
+struct InstanceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianTag;
+    int32_t maxRow;
+    int32_t maxBay;
+    int32_t maxLevel;
+    int32_t totalBoxes;
+    double timeTravelUnit;
+    double timeHandle;
+    double timeProcess;
+    int32_t boxCapacity;     // YardSystem::BOX_CAPACITY
+    int32_t boxCount;        // boxes in the yard
+    uint64_t stateHash;      // YardSystem::stateHash of the stored yard
+    uint64_t gridOffset;     // byte offsets from the start of the file
+    uint64_t locationOffset;
+    uint64_t commandOffset;
+    uint64_t commandCount;
+};
+
+struct InstanceCommandRecord {
+    int32_t cmd_no;
+    int32_t batch_id;
+    int32_t cmd_priority;
+    int32_t parent_carrier_id;
+    int32_t source[3];
+    int32_t dest[3];
+    int64_t create_time;
+    char cmd_type[16];       // NUL-padded
+};
+
+static_assert(sizeof(InstanceHeader) % 8 == 0, "InstanceHeader must keep the sections 8-byte aligned");
+static_assert(sizeof(InstanceCommandRecord) == 64, "InstanceCommandRecord layout changed: bump INSTANCE_FORMAT_VERSION");
+
+// Everything one experiment needs, as loaded from CSVs or a .brp file
+struct YardInstance {
+    YardConfig config;
+    YardSystem yard;               // no ranks attached
+    std::vector<Command> commands;
+};
+
+class InstanceFile {
+public:
+    // Yard + commands from the CSV trio (yard_config.csv, mock_yard.csv, mock_commands.csv)
+    static bool loadCsv(const std::string& configFile, const std::string& yardFile, const std::string& commandFile,
+                        YardInstance& out, std::string& error) {
+        out.config = DataLoader::loadYardConfig(configFile);
+        if (out.config.max_row == 0) { error = "cannot load " + configFile; return false; }
+        std::vector<BoxSnapshot> boxes = DataLoader::loadYardSnapshot(yardFile);
+        if (boxes.empty()) { error = "cannot load " + yardFile; return false; }
+        out.commands = DataLoader::loadCommands(commandFile);
+        if (out.commands.empty()) { error = "cannot load " + commandFile; return false; }
+
+        out.yard = YardSystem(out.config.max_row, out.config.max_bay, out.config.max_level, out.config.total_boxes);
+        for (const auto& box : boxes) out.yard.initBox(box.container_id, box.row, box.bay, box.level);
+        return true;
+    }
+
+    static bool write(const std::string& filename, const YardInstance& instance, std::string& error) {
+        const YardSystem& yard = instance.yard;
+        if (yard.rankOf) { error = "yard has ranks attached"; return false; }
+        if (yard.MAX_ROWS != instance.config.max_row || yard.MAX_BAYS != instance.config.max_bay
+            || yard.MAX_TIERS != instance.config.max_level) {
+            error = "yard dimensions do not match the config";
+            return false;
+        }
+
+        uint64_t gridInts = (uint64_t)yard.minRankOffset();
+        uint64_t locationInts = 3 * (uint64_t)yard.BOX_CAPACITY;
+
+        InstanceHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, INSTANCE_MAGIC, sizeof(header.magic));
+        header.version = INSTANCE_FORMAT_VERSION;
+        header.endianTag = INSTANCE_ENDIAN_TAG;
+        header.maxRow = instance.config.max_row;
+        header.maxBay = instance.config.max_bay;
+        header.maxLevel = instance.config.max_level;
+        header.totalBoxes = instance.config.total_boxes;
+        header.timeTravelUnit = instance.config.time_travel_unit;
+        header.timeHandle = instance.config.time_handle;
+        header.timeProcess = instance.config.time_process;
+        header.boxCapacity = yard.BOX_CAPACITY;
+        header.stateHash = yard.stateHash;
+        for (int c = 0; c < yard.MAX_ROWS * yard.MAX_BAYS; ++c) header.boxCount += yard.storage[c];
+        header.gridOffset = sizeof(InstanceHeader);
+        header.locationOffset = align8(header.gridOffset + gridInts * sizeof(int32_t));
+        header.commandOffset = align8(header.locationOffset + locationInts * sizeof(int32_t));
+        header.commandCount = instance.commands.size();
+
+        std::vector<InstanceCommandRecord> records(instance.commands.size());
+        for (size_t i = 0; i < instance.commands.size(); ++i) {
+            const Command& cmd = instance.commands[i];
+            InstanceCommandRecord& rec = records[i];
+            std::memset(&rec, 0, sizeof(rec));
+            if (cmd.cmd_type.size() >= sizeof(rec.cmd_type)) {
+                error = "command type '" + cmd.cmd_type + "' is too long";
+                return false;
+            }
+            rec.cmd_no = cmd.cmd_no;
+            rec.batch_id = cmd.batch_id;
+            rec.cmd_priority = cmd.cmd_priority;
+            rec.parent_carrier_id = cmd.parent_carrier_id;
+            rec.source[0] = cmd.source_position.row;
+            rec.source[1] = cmd.source_position.bay;
+            rec.source[2] = cmd.source_position.level;
+            rec.dest[0] = cmd.dest_position.row;
+            rec.dest[1] = cmd.dest_position.bay;
+            rec.dest[2] = cmd.dest_position.level;
+            rec.create_time = cmd.create_time;
+            std::memcpy(rec.cmd_type, cmd.cmd_type.data(), cmd.cmd_type.size());
+        }
+
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file) { error = "cannot write " + filename; return false; }
+        const char padding[8] = {0};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(yard.storage.data()), gridInts * sizeof(int32_t));
+        file.write(padding, header.locationOffset - (header.gridOffset + gridInts * sizeof(int32_t)));
+        file.write(reinterpret_cast<const char*>(yard.storage.data() + yard.locationOffset()), locationInts * sizeof(int32_t));
+        file.write(padding, header.commandOffset - (header.locationOffset + locationInts * sizeof(int32_t)));
+        if (!records.empty()) file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(InstanceCommandRecord));
+        if (!file) { error = "write to " + filename + " failed"; return false; }
+        return true;
+    }
+
+    static bool load(const std::string& filename, YardInstance& out, std::string& error) {
+        MappedFile file(filename);
+        if (!file.isOpen()) { error = "cannot open " + filename; return false; }
+        uint64_t size = (uint64_t)(file.end() - file.begin());
+
+        InstanceHeader header;
+        if (size < sizeof(header)) { error = filename + ": truncated header"; return false; }
+        std::memcpy(&header, file.begin(), sizeof(header));
+        if (std::memcmp(header.magic, INSTANCE_MAGIC, sizeof(header.magic)) != 0) { error = filename + ": not a .brp instance"; return false; }
+        if (header.endianTag != INSTANCE_ENDIAN_TAG) { error = filename + ": written with a different byte order"; return false; }
+        if (header.version != INSTANCE_FORMAT_VERSION) {
+            error = filename + ": format version " + std::to_string(header.version) + ", expected " + std::to_string(INSTANCE_FORMAT_VERSION);
+            return false;
+        }
+        if (header.maxRow <= 0 || header.maxBay <= 0 || header.maxLevel <= 0 || header.boxCapacity <= 0) {
+            error = filename + ": invalid dimensions";
+            return false;
+        }
+
+        // Section sizes from header fields: check them against the file before multiplying or allocating
+        uint64_t columns = (uint64_t)header.maxRow * (uint64_t)header.maxBay;
+        if (!sectionFits(header.gridOffset, columns, (1 + (uint64_t)header.maxLevel) * sizeof(int32_t), size)
+            || !sectionFits(header.locationOffset, (uint64_t)header.boxCapacity, 3 * sizeof(int32_t), size)
+            || !sectionFits(header.commandOffset, header.commandCount, sizeof(InstanceCommandRecord), size)) {
+            error = filename + ": truncated sections";
+            return false;
+        }
+        // YardSystem indexes its flat storage with int
+        if (columns > INT32_MAX || columns * (1 + 3 * (uint64_t)header.maxLevel) + 3 * (uint64_t)header.boxCapacity > INT32_MAX) {
+            error = filename + ": yard too large";
+            return false;
+        }
+
+        YardSystem& yard = out.yard;
+        yard = YardSystem(header.maxRow, header.maxBay, header.maxLevel, header.boxCapacity - 1);
+        uint64_t gridInts = (uint64_t)yard.minRankOffset();
+        uint64_t locationInts = 3 * (uint64_t)yard.BOX_CAPACITY;
+
+        // Straight into the flat layout: tops + grid, then the box lookup table
+        std::memcpy(yard.storage.data(), file.begin() + header.gridOffset, gridInts * sizeof(int32_t));
+        std::memcpy(yard.storage.data() + yard.locationOffset(), file.begin() + header.locationOffset, locationInts * sizeof(int32_t));
+        yard.stateHash = header.stateHash;
+        int boxCount = 0;
+        for (int c = 0; c < yard.MAX_ROWS * yard.MAX_BAYS; ++c) {
+            int h = yard.storage[c];
+            if (h < 0 || h > yard.MAX_TIERS) { error = filename + ": corrupt column heights"; return false; }
+            boxCount += h;
+        }
+        if (boxCount != header.boxCount) { error = filename + ": box count does not match the grid"; return false; }
+        if (!checkBoxes(yard)) { error = filename + ": grid and box locations do not match"; return false; }
+
+        out.config.max_row = header.maxRow;
+        out.config.max_bay = header.maxBay;
+        out.config.max_level = header.maxLevel;
+        out.config.total_boxes = header.totalBoxes;
+        out.config.time_travel_unit = header.timeTravelUnit;
+        out.config.time_handle = header.timeHandle;
+        out.config.time_process = header.timeProcess;
+
+        out.commands.clear();
+        out.commands.reserve((size_t)header.commandCount);
+        const char* p = file.begin() + header.commandOffset;
+        for (uint64_t i = 0; i < header.commandCount; ++i, p += sizeof(InstanceCommandRecord)) {
+            InstanceCommandRecord rec;
+            std::memcpy(&rec, p, sizeof(rec));
+            Command cmd;
+            cmd.cmd_no = rec.cmd_no;
+            cmd.batch_id = rec.batch_id;
+            cmd.cmd_type.assign(rec.cmd_type, strnlen(rec.cmd_type, sizeof(rec.cmd_type)));
+            cmd.cmd_priority = rec.cmd_priority;
+            cmd.parent_carrier_id = rec.parent_carrier_id;
+            cmd.source_position = {rec.source[0], rec.source[1], rec.source[2]};
+            cmd.dest_position = {rec.dest[0], rec.dest[1], rec.dest[2]};
+            cmd.create_time = rec.create_time;
+            out.commands.push_back(cmd);
+        }
+        return true;
+    }
+
+    // Boxes of a yard as snapshot rows (id order), e.g. for the Python binding
+    static std::vector<BoxSnapshot> snapshot(const YardSystem& yard) {
+        std::vector<BoxSnapshot> boxes;
+        for (int id = 0; id < yard.BOX_CAPACITY; ++id) {
+            Coordinate pos = yard.getBoxPosition(id);
+            if (pos.row != -1) boxes.push_back({id, pos.row, pos.bay, pos.tier});
+        }
+        return boxes;
+    }
+
+private:
+    static uint64_t align8(uint64_t offset) { return (offset + 7) & ~(uint64_t)7; }
+
+    // count elements of elemBytes starting at offset lie inside a file of `size` bytes (no overflow)
+    static bool sectionFits(uint64_t offset, uint64_t count, uint64_t elemBytes, uint64_t size) {
+        return offset <= size && count <= (size - offset) / elemBytes;
+    }
+
+    // Every stacked box has an id in (0, BOX_CAPACITY) whose location is that slot, and every
+    // location in the yard points at a stacked slot holding that box (heights already checked)
+    static bool checkBoxes(const YardSystem& yard) {
+        for (int r = 0; r < yard.MAX_ROWS; ++r) {
+            for (int b = 0; b < yard.MAX_BAYS; ++b) {
+                for (int t = 0; t < yard.getHeight(r, b); ++t) {
+                    int id = yard.getBoxAt(r, b, t);
+                    if (id <= 0 || id >= yard.BOX_CAPACITY) return false;
+                    Coordinate pos = yard.getBoxPosition(id);
+                    if (pos.row != r || pos.bay != b || pos.tier != t) return false;
+                }
+            }
+        }
+        for (int id = 0; id < yard.BOX_CAPACITY; ++id) {
+            Coordinate pos = yard.getBoxPosition(id);
+            if (pos.row == -1) continue; // Not in the yard (or at a port)
+            if (pos.row < 0 || pos.row >= yard.MAX_ROWS || pos.bay < 0 || pos.bay >= yard.MAX_BAYS
+                || pos.tier < 0 || pos.tier >= yard.getHeight(pos.row, pos.bay) || yard.getBoxAt(pos.row, pos.bay, pos.tier) != id) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // INSTANCEFILE_H
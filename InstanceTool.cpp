@@ -0,0 +1,59 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstring>
+
+#include "InstanceFile.h"
+
+// Converts the CSV trio into a binary instance (.brp), or prints a summary of one.
+// Build: g++ -O2 -std=c++11 InstanceTool.cpp -o instance_tool
+
+static int printInfo(const std::string& filename) {
+    YardInstance instance;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    if (!InstanceFile::load(filename, instance, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    int boxes = 0;
+    for (int r = 0; r < instance.yard.MAX_ROWS; ++r)
+        for (int b = 0; b < instance.yard.MAX_BAYS; ++b) boxes += instance.yard.getHeight(r, b);
+
+    std::cout << filename << " (format v" << INSTANCE_FORMAT_VERSION << ", loaded in " << ms << " ms)" << std::endl;
+    std::cout << "Grid Size     : " << instance.config.max_row << " x " << instance.config.max_bay << " x " << instance.config.max_level << std::endl;
+    std::cout << "Total Boxes   : " << instance.config.total_boxes << " (" << boxes << " in the yard)" << std::endl;
+    std::cout << "Time Config   : Travel=" << instance.config.time_travel_unit << "s, Handle=" << instance.config.time_handle
+              << "s, Process=" << instance.config.time_process << "s" << std::endl;
+    std::cout << "Commands      : " << instance.commands.size() << std::endl;
+    std::cout << "State Hash    : " << std::hex << instance.yard.stateHash << std::dec << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::strcmp(argv[1], "--info") == 0) return printInfo(argv[2]);
+
+    if (argc != 2 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <Output.brp> [yard_config.csv mock_yard.csv mock_commands.csv]" << std::endl;
+        std::cerr << "       " << argv[0] << " --info <Instance.brp>" << std::endl;
+        return 1;
+    }
+
+    std::string output = argv[1];
+    std::string configFile = argc == 5 ? argv[2] : "yard_config.csv";
+    std::string yardFile = argc == 5 ? argv[3] : "mock_yard.csv";
+    std::string commandFile = argc == 5 ? argv[4] : "mock_commands.csv";
+
+    YardInstance instance;
+    std::string error;
+    if (!InstanceFile::loadCsv(configFile, yardFile, commandFile, instance, error)
+        || !InstanceFile::write(output, instance, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << output << ": " << instance.config.max_row << "x" << instance.config.max_bay << "x"
+              << instance.config.max_level << ", " << instance.commands.size() << " commands" << std::endl;
+    return 0;
+}
@@ -0,0 +1,1402 @@
+#ifndef MAKESPANSOLVER_H
+#define MAKESPANSOLVER_H
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "YardSystem.h"
+#include "BeamSelect.h"
+#include "PrefixCheckpoint.h"
+#include "SearchStats.h"
+
+// ==========================================
+// Multi-AGV Makespan Beam Search (README §3-§4)
+// Shared by the native CLI (main.cpp) and the Python binding (bs_solver.pyx).
+// Each layer expands every node by one mission of the current target:
+//   Case A DONE / Case B RETURN (Port -> Yard) / Case C RETRIEVE (Yard -> Port) / Case D RESHUFFLE
+// Children are first scored against their parent (ExpandCandidate), optionally checked by
+// the Front Rule (README §5), and only the beamWidth survivors are copied into full SearchNodes.
+// With adaptiveWidth, each layer keeps only the children close to its best f (README §4.5).
+// With destinationCandidates, returns and reshuffles only try the best-k columns of the yard's
+// destination index instead of every column (README §4.6).
+// Built with -fopenmp, the parents of a layer are expanded in parallel.
+// ==========================================
+
+// Front Rule (README §5): a child whose last few missions finish earlier on other AGVs is dominated
+enum FrontRuleMode {
+    FRONT_RULE_OFF = 0,
+    FRONT_RULE_PRUNE = 1,    // drop dominated children
+    FRONT_RULE_REPLACE = 2   // re-time dominated children with their best AGV assignment
+};
+
+struct SolverConfig {
+    double timeTravelUnit;  // seconds per row / bay
+    double timeHandle;      // pick-up or drop-off
+    double timeProcess;     // workstation processing
+    int agvCount;
+    int beamWidth;
+    int portCount;          // ports 1..portCount, all at (0, 0) for travel purposes
+    int numThreads;         // beam expansion threads (0 = OpenMP default)
+    bool dedupStates;       // keep only the best-f node per (yard, AGV) state in each layer
+    int checkpointStride;   // resumable evaluation: save the beam after every N-th target
+    int frontRule;          // FrontRuleMode
+    int frontWindow;        // missions re-timed by the Front Rule (<= MAX_FRONT_TASKS)
+    int frontShortlist;     // Front Rule checks the frontShortlist * beamWidth best children per layer (0 = all)
+    bool adaptiveWidth;     // per-layer width in [minBeamWidth, beamWidth] from the spread of the children's f
+    int minBeamWidth;
+    double widthGap;        // adaptive: children within widthGap (seconds of f) of the layer's best are kept
+    long long nodeBudget;   // adaptive: candidates scored per solve, paced over the targets (0 = no limit)
+    int destinationCandidates;  // Case B / D score only this many destination columns from the yard's index (0 = all)
+    double penaltyBlocking;
+    double penaltyLookahead;
+
+    SolverConfig()
+        : timeTravelUnit(5.0), timeHandle(30.0), timeProcess(10.0), agvCount(3), beamWidth(100),
+          portCount(5), numThreads(0), dedupStates(true), checkpointStride(2),
+          frontRule(FRONT_RULE_OFF), frontWindow(3), frontShortlist(4), adaptiveWidth(false), minBeamWidth(1),
+          widthGap(5.0), nodeBudget(0), destinationCandidates(0), penaltyBlocking(2000.0), penaltyLookahead(500.0) {}
+};
+
+struct Agent {
+    int id;
+    Coordinate currentPos;
+    double availableTime;
+};
+
+const int MAX_FRONT_TASKS = 4;  // longest front window
+const int MAX_FRONT_AGVS = 4;   // all agvCount! relabelings are tried, so the rule is skipped above this
+const int MAX_FRONT_PERMS = 24; // MAX_FRONT_AGVS!
+
+// One mission of a node's front window, with what it takes to re-time it on another AGV.
+// Resources are keyed as a column index (>= 0) or -port.
+struct FrontTask {
+    int caseType;        // 1 = RETURN, 2 = RETRIEVE, 3 = RESHUFFLE
+    int agv;
+    Coordinate src;
+    Coordinate dst;
+    int srcKey;          // resource at the source (column, or the port of a RETURN)
+    int dstKey;          // resource at the destination (column, or the port of a RETRIEVE)
+    double srcReady;     // busy-until times of those resources when the mission was scheduled
+    double dstReady;
+    Coordinate agvPos;   // the AGV's state before the mission
+    double agvTime;
+    double startTime;
+    double releaseTime;
+    double makespan;     // g right after the mission
+};
+
+// Resource times written while re-timing a front window, in order
+struct FrontWrites {
+    int keys[2 * MAX_FRONT_TASKS];
+    double values[2 * MAX_FRONT_TASKS];
+    int count;
+
+    FrontWrites() : count(0) {}
+
+    double read(int key, double fallback) const {
+        for (int i = count - 1; i >= 0; --i) {
+            if (keys[i] == key) return values[i];
+        }
+        return fallback;
+    }
+
+    void write(int key, double value) {
+        keys[count] = key;
+        values[count] = value;
+        count++;
+    }
+};
+
+// Solver time 0 in epoch seconds: mission log timestamps and command create_time share this base
+const long long MISSION_EPOCH = 1705363200;
+
+// Timed mission (README §6.2)
+struct MissionLog {
+    int mission_no;
+    int agv_id;
+    int batch_id;
+    int container_id;
+    int related_target_id;
+    Coordinate src;
+    Coordinate dst;         // (-1, -1, port) for a retrieval
+    int mission_priority;
+    long long start_time_epoch;
+    long long end_time_epoch;
+    double makespan_snapshot;
+    int type_code;          // 0 = target, 1 = reshuffle, 2 = return
+    int mission_status;
+
+    bool operator<(const MissionLog& other) const {
+        return start_time_epoch < other.start_time_epoch;
+    }
+};
+
+struct SearchNode {
+    YardSystem yard;
+    std::vector<Agent> agvs;
+    double g;
+    double h;
+    double f;
+    std::vector<double> gridBusyTime; // indexed by yard.columnIndex(r, b)
+    std::vector<double> portsBusyTime;
+
+    bool isCurrentTargetRetrieved;
+    // Undivided 3D UBALB: sum of the contributions of every target still in the yard
+    // whose rank is >= current seqIdx (+1 once the current target is retrieved)
+    double ubalbSum;
+    int historyTail;    // latest mission in the history arena (-1 = none)
+    int historyLength;
+    // Front Rule: the latest missions, oldest first
+    FrontTask frontTasks[MAX_FRONT_TASKS];
+    int frontCount;
+
+    bool operator<(const SearchNode& other) const {
+        return f < other.f;
+    }
+};
+
+// Width one layer was cut to (adaptive width, README §4.5)
+struct LayerWidth {
+    int seqIdx;
+    int layer;             // expansion step within that target (1-based)
+    int width;             // survivors allowed
+    long long candidates;  // children scored
+};
+
+// Approximate footprint of one node copy (checkpoint budget, instrumentation)
+inline size_t nodeBytes(const SearchNode& node) {
+    return sizeof(SearchNode) + node.yard.storage.size() * sizeof(int)
+         + (node.gridBusyTime.size() + node.portsBusyTime.size()) * sizeof(double) + node.agvs.size() * sizeof(Agent);
+}
+
+// Persistent mission history: nodes share their common prefix through parent links,
+// the full log is only rebuilt for the winning node.
+struct HistoryEntry {
+    MissionLog log;
+    int prev;
+};
+
+inline std::vector<MissionLog> rebuildHistory(const std::vector<HistoryEntry>& arena, int tail) {
+    std::vector<MissionLog> logs;
+    for (int e = tail; e != -1; e = arena[e].prev) logs.push_back(arena[e].log);
+    std::reverse(logs.begin(), logs.end());
+    return logs;
+}
+
+// Stage 1 of expansion: a child scored against its parent without copying it.
+// Only candidates that survive the beamWidth cut are materialized into SearchNodes.
+struct ExpandCandidate {
+    int parent;          // index into currentBeam
+    int caseType;        // 0 = DONE, 1 = RETURN, 2 = RETRIEVE, 3 = RESHUFFLE
+    Coordinate src;
+    Coordinate dst;      // yard slot, or (-1, -1, port) for RETRIEVE
+    int agv;
+    double startTime;
+    double finishTime;   // drop-off done (RETURN / RESHUFFLE), port done (RETRIEVE)
+    double releaseTime;  // when the AGV becomes free again
+    double pickupTime;   // when the source column is free again
+    double g;
+    double h;
+    double f;
+    double ubalbSum;          // child's undivided UBALB (h = ubalbSum / agvCount)
+    unsigned long long yardHash; // child yard's Zobrist hash
+    unsigned long long hash;  // child state hash, for per-layer deduplication
+    int frontPerm;            // Front Rule relabeling to apply (index into SolveTables::frontPerms, 0 = none)
+
+    bool operator<(const ExpandCandidate& other) const {
+        return f < other.f;
+    }
+};
+
+// Tie-break noise in [0, 0.01): a pure function of the candidate (no global RNG state),
+// so it is thread-safe and the beam is reproducible for any thread count.
+inline double tieBreakNoise(size_t seqIdx, int layer, int parent, int slot) {
+    unsigned long long x = 12345ULL;
+    x = x * 0x9E3779B97F4A7C15ULL + seqIdx;
+    x = x * 0x9E3779B97F4A7C15ULL + (unsigned long long)layer;
+    x = x * 0x9E3779B97F4A7C15ULL + (unsigned long long)parent;
+    x = x * 0x9E3779B97F4A7C15ULL + (unsigned long long)(slot + 1);
+    // splitmix64 finalizer
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27; x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return (double)(x >> 11) * (1.0 / 9007199254740992.0) * 0.01;
+}
+
+// State hash of a child node: yard configuration + AGV states + retrieval flag.
+// changedAgv's position / release time are replaced by the child's values.
+inline unsigned long long nodeStateHash(unsigned long long yardHash, const std::vector<Agent>& agvs,
+                                        int changedAgv, Coordinate newPos, double newTime, bool retrieved) {
+    unsigned long long h = yardHash ^ (retrieved ? 0x5851F42D4C957F2DULL : 0ULL);
+    for (size_t i = 0; i < agvs.size(); ++i) {
+        bool changed = (int)i == changedAgv;
+        Coordinate pos = changed ? newPos : agvs[i].currentPos;
+        double t = changed ? newTime : agvs[i].availableTime;
+        unsigned long long bits;
+        std::memcpy(&bits, &t, sizeof(bits));
+        h ^= zobristKey((int)i, pos.row * 4096 + pos.bay * 64 + pos.tier) * 31 + zobristKey(-1 - (int)i, (int)(bits ^ (bits >> 32)));
+        h = (h ^ (h >> 29)) * 0xBF58476D1CE4E5B9ULL;
+    }
+    return h;
+}
+
+// Progress hook: (ctx, elapsed sec, best makespan so far, candidates scored per sec) -> keep going?
+// Plain function pointer + context so the Python binding can forward to a callable.
+typedef int (*SolveProgressFn)(void* ctx, double elapsed, double best, double evalsPerSec);
+
+// Makespan reported for a sequence the beam cannot complete
+const double DEAD_END_MAKESPAN = 1e9;
+
+class MakespanSolver {
+public:
+    // Beam state after the first k targets, used to resume GA evaluations
+    typedef PrefixCheckpointStore<std::vector<SearchNode>> CheckpointStore;
+    typedef CheckpointStore::Checkpoint Checkpoint;
+
+    explicit MakespanSolver(const SolverConfig& solverConfig) : config(solverConfig) {}
+
+    const SolverConfig& getConfig() const { return config; }
+
+    // Full plan: the mission log of the best final node (empty on a dead end).
+    // timeBudget > 0: after that many seconds (or when progress() returns 0) the beam
+    // collapses to its best node and the remaining targets are planned with width 1,
+    // so a complete best-so-far plan is still returned.
+    // stats: filled when built with -DBBS_STATS (SearchStats.h), otherwise left untouched
+    // widths: the width of every layer (always available, interesting with adaptiveWidth)
+    std::vector<MissionLog> solve(const YardSystem& initialYard, const std::vector<int>& seq,
+                                  double timeBudget = 0, SolveProgressFn progress = nullptr, void* progressCtx = nullptr,
+                                  SearchStats* stats = nullptr, std::vector<LayerWidth>* widths = nullptr) const {
+        std::vector<HistoryEntry> history;
+        RunOptions options;
+        options.history = &history;
+        options.timeBudget = timeBudget;
+        options.progress = progress;
+        options.progressCtx = progressCtx;
+        options.stats = stats;
+        options.widths = widths;
+        std::vector<SearchNode> beam = run(initialYard, seq, options);
+        if (beam.empty()) return std::vector<MissionLog>();
+        return rebuildHistory(history, beam[0].historyTail);
+    }
+
+    // Makespan only (for GA fitness): no mission history is recorded
+    double evaluate(const YardSystem& initialYard, const std::vector<int>& seq) const {
+        RunOptions options;
+        std::vector<SearchNode> beam = run(initialYard, seq, options);
+        return beam.empty() ? DEAD_END_MAKESPAN : beam[0].g;
+    }
+
+    // Resumable evaluation: starts from the longest prefix found in `store` (only read here)
+    // and appends the checkpoints it passes to `saved`, for the caller to insert later.
+    // Penalties look at the ranks of *later* targets, so a resumed result (resumed = true)
+    // can differ slightly from evaluate(); the GA treats it as approximate.
+    double evaluateResumable(const YardSystem& initialYard, const std::vector<int>& seq,
+                             CheckpointStore& store, std::vector<Checkpoint>& saved, bool& resumed) const {
+        RunOptions options;
+        options.store = &store;
+        options.saved = &saved;
+        options.resumed = &resumed;
+        std::vector<SearchNode> beam = run(initialYard, seq, options);
+        return beam.empty() ? DEAD_END_MAKESPAN : beam[0].g;
+    }
+
+    // Rolling horizon (RollingPlanner.h): the same entry points, continuing from a committed
+    // state (yard + AGV / column / port busy times, see commitMission) instead of an idle yard.
+    // `start` must sit between two targets; its missions are not part of the returned log.
+    std::vector<MissionLog> solve(const SearchNode& start, const std::vector<int>& seq, double timeBudget = 0) const {
+        std::vector<HistoryEntry> history;
+        RunOptions options;
+        options.start = &start;
+        options.history = &history;
+        options.timeBudget = timeBudget;
+        std::vector<SearchNode> beam = run(start.yard, seq, options);
+        if (beam.empty()) return std::vector<MissionLog>();
+        return rebuildHistory(history, beam[0].historyTail);
+    }
+
+    double evaluate(const SearchNode& start, const std::vector<int>& seq) const {
+        RunOptions options;
+        options.start = &start;
+        std::vector<SearchNode> beam = run(start.yard, seq, options);
+        return beam.empty() ? DEAD_END_MAKESPAN : beam[0].g;
+    }
+
+    double evaluateResumable(const SearchNode& start, const std::vector<int>& seq,
+                             CheckpointStore& store, std::vector<Checkpoint>& saved, bool& resumed) const {
+        RunOptions options;
+        options.start = &start;
+        options.store = &store;
+        options.saved = &saved;
+        options.resumed = &resumed;
+        std::vector<SearchNode> beam = run(start.yard, seq, options);
+        return beam.empty() ? DEAD_END_MAKESPAN : beam[0].g;
+    }
+
+    // Idle state of a yard: AGVs free at (0, 0), every column and port free at time 0, no ranks
+    SearchNode initialState(const YardSystem& initialYard) const {
+        SearchNode state;
+        state.yard = initialYard;
+        state.g = 0;
+        state.h = 0;
+        state.f = 0;
+        state.isCurrentTargetRetrieved = false;
+        state.ubalbSum = 0;
+        state.historyTail = -1;
+        state.historyLength = 0;
+        state.frontCount = 0;
+        state.gridBusyTime.assign(initialYard.MAX_ROWS * initialYard.MAX_BAYS, 0.0);
+        state.portsBusyTime.assign(config.portCount + 1, 0.0);
+
+        Agent agv;
+        agv.currentPos = Coordinate(0, 0, 0);
+        agv.availableTime = 0.0;
+        for (int i = 0; i < config.agvCount; ++i) {
+            agv.id = i;
+            state.agvs.push_back(agv);
+        }
+        return state;
+    }
+
+    // Executes a planned mission on a committed state (no ranks needed): the mission keeps its AGV,
+    // source, destination and port but is re-timed from `state`, so AGV / port updates received
+    // since it was planned are honoured. Its start / end / makespan fields are updated in place.
+    void commitMission(SearchNode& state, MissionLog& log) const {
+        FrontTask t;
+        t.caseType = log.type_code == 2 ? 1 : log.type_code == 0 ? 2 : 3;
+        t.agv = log.agv_id;
+        t.src = log.src;
+        t.dst = log.dst;
+        t.srcKey = t.caseType == 1 ? -t.src.tier : state.yard.columnIndex(t.src.row, t.src.bay);
+        t.dstKey = t.caseType == 2 ? -t.dst.tier : state.yard.columnIndex(t.dst.row, t.dst.bay);
+
+        FrontWrites writes;
+        double start;
+        double release = replayFrontTask(t, state.agvs[t.agv], resourceTime(state, t.srcKey), resourceTime(state, t.dstKey),
+                                         &writes, start);
+        for (int i = 0; i < writes.count; ++i) {
+            if (writes.keys[i] >= 0) state.gridBusyTime[writes.keys[i]] = writes.values[i];
+            else state.portsBusyTime[-writes.keys[i]] = writes.values[i];
+        }
+        if (t.caseType == 1) state.yard.returnFromPort(log.container_id, t.dst.row, t.dst.bay);
+        else if (t.caseType == 2) state.yard.moveToPort(log.container_id, t.dst.tier);
+        else state.yard.moveBox(t.src.row, t.src.bay, t.dst.row, t.dst.bay);
+
+        state.g = 0;
+        for (const auto& agv : state.agvs) state.g = std::fmax(state.g, agv.availableTime);
+        log.start_time_epoch = (long long)start + MISSION_EPOCH;
+        log.end_time_epoch = (long long)release + MISSION_EPOCH;
+        log.makespan_snapshot = state.g;
+    }
+
+    // --- Building blocks of run(), public so Benchmark.cpp can time them in isolation ---
+
+    // Per-solve constants: rank table (attached to every yard) + incremental 3D UBALB costs
+    struct SolveTables {
+        std::vector<int> rankOf;         // box id -> index in seq (NO_RANK = not a target)
+        std::vector<double> columnCost;  // per column: retrieve + process + return of an unblocked target
+        double blockerCost;              // relocation of one blocking box
+        int frontWindow;                 // missions re-timed by the Front Rule (0 = off)
+        std::vector<int> frontPerms;     // every permutation of the AGV labels, agvCount each, identity first
+    };
+
+    // Front Rule outcome for one parent's children
+    struct FrontRuleCounts {
+        long long checked;
+        long long pruned;
+        long long improved;
+    };
+
+    // Scratch buffers of expandLayer(), reused from layer to layer
+    struct LayerWorkspace {
+        std::vector<std::vector<ExpandCandidate>> buffers;  // per parent
+        std::vector<ExpandCandidate> candidates;            // merged, in parent order
+        std::vector<SearchNode> nextBeam;
+        std::vector<double> scores;                         // Front Rule shortlist cutoff
+        int lastWidth;                                      // width the last layer was cut to
+        SearchStats* stats;                                 // instrumentation (nullptr = off)
+#ifdef BBS_STATS
+        std::vector<double> expandSec;                      // per parent
+        std::vector<double> frontSec;
+        std::vector<FrontRuleCounts> frontCounts;
+#endif
+
+        LayerWorkspace() : lastWidth(0), stats(nullptr) {}
+    };
+
+    // Root node of a solve: initial yard with the sequence's ranks attached, AGVs idle at (0, 0)
+    SearchNode makeRoot(const YardSystem& initialYard, const SolveTables& tables, const std::vector<int>& seq) const {
+        SearchNode root = initialState(initialYard);
+        attachSolveRanks(root.yard, tables, 0);
+        root.ubalbSum = calculate3DUbalb(root.yard, tables, seq, 0);
+        return root;
+    }
+
+    // Root of a solve continuing from a committed state: its yard gets this sequence's ranks,
+    // AGVs / columns / ports keep their busy times, the history and the Front Rule window start
+    // empty (committed missions are never re-timed)
+    SearchNode makeRoot(const SearchNode& state, const SolveTables& tables, const std::vector<int>& seq) const {
+        SearchNode root = state;
+        root.g = 0;
+        for (const auto& agv : root.agvs) root.g = std::fmax(root.g, agv.availableTime);
+        root.h = 0;
+        root.f = root.g;
+        root.isCurrentTargetRetrieved = false;
+        root.historyTail = -1;
+        root.historyLength = 0;
+        root.frontCount = 0;
+        attachSolveRanks(root.yard, tables, 0);
+        root.ubalbSum = calculate3DUbalb(root.yard, tables, seq, 0);
+        return root;
+    }
+
+    // One beam layer: every node of `beam` gets one more mission of targetId and the `width`
+    // best children replace it (with adaptiveWidth, `width` is the upper bound; ws.lastWidth holds
+    // the width used). Returns the number of candidates scored (0 = no child at all, beam left
+    // unchanged); targetCycleDone is set once the current target is finished.
+    size_t expandLayer(std::vector<SearchNode>& beam, LayerWorkspace& ws, int targetId, size_t seqIdx, int layer, int width,
+                       const SolveTables& tables, std::vector<HistoryEntry>* history, bool& targetCycleDone) const {
+        // Stage 1 (parallel): each parent fills its own buffer, so the merged
+        // candidate order does not depend on thread scheduling
+        int beamSize = (int)beam.size();
+        if ((int)ws.buffers.size() < beamSize) ws.buffers.resize(beamSize);
+        BBS_STAT(if (ws.stats) {
+            ws.expandSec.assign(beamSize, 0.0);
+            ws.frontSec.assign(beamSize, 0.0);
+            ws.frontCounts.assign(beamSize, FrontRuleCounts());
+        });
+#ifdef _OPENMP
+        const int nthreads = expansionThreads();
+        #pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1 && beamSize > 1)
+#endif
+        for (int pk = 0; pk < beamSize; ++pk) {
+            ws.buffers[pk].clear();
+            BBS_TIMED(ws.stats ? &ws.expandSec[pk] : nullptr,
+                      expandNode(beam[pk], pk, targetId, seqIdx, layer, tables, ws.buffers[pk]));
+        }
+
+        // Front Rule pruning stage, on the children that can still make the cut
+        if (tables.frontWindow > 0) {
+            double cutoff = frontRuleCutoff(ws, beamSize, width);
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1 && beamSize > 1)
+#endif
+            for (int pk = 0; pk < beamSize; ++pk) {
+                FrontRuleCounts* counts = nullptr;
+                BBS_STAT(if (ws.stats) counts = &ws.frontCounts[pk]);
+                BBS_TIMED(ws.stats ? &ws.frontSec[pk] : nullptr, applyFrontRule(beam[pk], tables, ws.buffers[pk], cutoff, counts));
+            }
+        }
+
+        ws.candidates.clear();
+        for (int k = 0; k < beamSize; ++k) {
+            BBS_STAT(if (ws.stats) ws.stats->addExpansion(ws.buffers[k].empty() ? CASE_RESHUFFLE : ws.buffers[k][0].caseType,
+                                                          (long long)ws.buffers[k].size(), ws.expandSec[k]));
+            BBS_STAT(if (ws.stats) ws.stats->addFrontRule(ws.frontCounts[k].checked, ws.frontCounts[k].pruned,
+                                                          ws.frontCounts[k].improved, ws.frontSec[k]));
+            for (const auto& c : ws.buffers[k]) {
+                if (c.caseType == 0) targetCycleDone = true;
+                ws.candidates.push_back(c);
+            }
+        }
+        if (ws.candidates.empty()) return 0;
+        std::vector<int> survivors;
+        {
+            BBS_PHASE_TIMER(ws.stats, PHASE_SELECT);
+            if (config.adaptiveWidth) width = adaptiveLayerWidth(ws.candidates, width);
+            ws.lastWidth = width;
+            survivors = selectTopCandidates(ws.candidates, width);
+        }
+
+        // Stage 2: materialize only the survivors
+        {
+            BBS_PHASE_TIMER(ws.stats, PHASE_COPY);
+            ws.nextBeam.clear();
+            ws.nextBeam.reserve(survivors.size());
+            for (int idx : survivors) {
+                ws.nextBeam.push_back(beam[ws.candidates[idx].parent]);
+                materializeCandidate(ws.nextBeam.back(), history, ws.candidates[idx], targetId, tables);
+                BBS_STAT(if (ws.stats) ws.stats->bytesCopied += (long long)nodeBytes(ws.nextBeam.back()));
+            }
+            beam.swap(ws.nextBeam);
+        }
+        BBS_STAT(if (ws.stats) ws.stats->addLayer((int)seqIdx, layer, (long long)ws.candidates.size(), (long long)survivors.size()));
+
+        Coordinate check = beam[0].yard.getBoxPosition(targetId);
+        if (check.row != -1 && beam[0].isCurrentTargetRetrieved) targetCycleDone = true;
+        return ws.candidates.size();
+    }
+
+private:
+
+    struct RunOptions {
+        const SearchNode* start;              // committed state to continue from (nullptr = idle initial yard)
+        std::vector<HistoryEntry>* history;  // nullptr = do not record missions
+        CheckpointStore* store;               // resume source (read only)
+        std::vector<Checkpoint>* saved;       // checkpoints passed, for the caller to insert
+        bool* resumed;                        // set when the run continued from a checkpoint
+        double timeBudget;
+        SolveProgressFn progress;
+        void* progressCtx;
+        SearchStats* stats;                   // instrumentation (only with -DBBS_STATS)
+        std::vector<LayerWidth>* widths;      // width of every layer (nullptr = not recorded)
+
+        RunOptions() : start(nullptr), history(nullptr), store(nullptr), saved(nullptr), resumed(nullptr), timeBudget(0),
+                       progress(nullptr), progressCtx(nullptr), stats(nullptr), widths(nullptr) {}
+    };
+
+    SolverConfig config;
+
+    // --- Timing Model ---
+
+    double getTravelTime(Coordinate src, Coordinate dst) const {
+        int r1 = src.row == -1 ? 0 : src.row;
+        int b1 = src.bay == -1 ? 0 : src.bay;
+        int r2 = dst.row == -1 ? 0 : dst.row;
+        int b2 = dst.bay == -1 ? 0 : dst.bay;
+        double dist = std::abs(r1 - r2) + std::abs(b1 - b2);
+        return dist * config.timeTravelUnit;
+    }
+
+    // g of the child: max AGV time with one AGV's release time replaced
+    double makespanWith(const SearchNode& node, int agv, double releaseTime) const {
+        double maxAGV = 0;
+        for (int i = 0; i < config.agvCount; ++i) {
+            maxAGV = std::fmax(maxAGV, i == agv ? releaseTime : node.agvs[i].availableTime);
+        }
+        return maxAGV;
+    }
+
+public:
+    // --- Penalties ---
+
+    double calculateRILPenalty(const YardSystem& yard, int r, int b, int currentSeqIdx, int movingBoxId) const {
+        int currentTop = yard.getHeight(r, b);
+        if (currentTop == 0) return 0.0;
+
+        int topBoxRank = yard.futureRank(yard.getBoxAt(r, b, currentTop - 1));
+        int movingBoxRank = yard.futureRank(movingBoxId);
+
+        // Boxes in the column needed before the moving one: the column summaries answer this
+        // in O(1) unless the moving box is itself a target and the column holds an earlier one
+        int blockingCount = 0;
+        if (yard.columnMinRank(r, b) >= movingBoxRank) {
+            blockingCount = 0;
+        } else if (movingBoxRank == NO_RANK) {
+            blockingCount = yard.columnTargetCount(r, b);
+        } else {
+            for (int t = 0; t < currentTop; ++t) {
+                if (yard.futureRank(yard.getBoxAt(r, b, t)) < movingBoxRank) blockingCount++;
+            }
+        }
+
+        if (blockingCount > 0) return config.penaltyBlocking * blockingCount;
+        if (topBoxRank > movingBoxRank) return 0.0;
+        if (topBoxRank > currentSeqIdx) return config.penaltyLookahead / (double)(topBoxRank - currentSeqIdx);
+        return 0.0;
+    }
+
+    static int calculateReturnPenalty(const YardSystem& yard, int r, int b, int currentSeqIdx) {
+        if (yard.columnTargetCount(r, b) == 0) return 0;
+        int penalty = 0;
+        for (int t = 0; t < yard.getHeight(r, b); ++t) {
+            int rank = yard.futureRank(yard.getBoxAt(r, b, t));
+            if (rank > currentSeqIdx && rank != NO_RANK) penalty += 1000 / (rank - currentSeqIdx + 1);
+        }
+        return penalty;
+    }
+
+    // --- Incremental 3D UBALB (README §4.2) ---
+
+    // Everything in the UBALB that depends only on the column, computed once per solve
+    void buildSolveTables(SolveTables& tables, const YardSystem& yard, const std::vector<int>& seq) const {
+        int capacity = yard.BOX_CAPACITY;
+        for (int id : seq) capacity = std::max(capacity, id + 1);
+        tables.rankOf.assign(capacity, NO_RANK);
+        for (size_t i = 0; i < seq.size(); ++i) {
+            if (tables.rankOf[seq[i]] == NO_RANK) tables.rankOf[seq[i]] = (int)i;
+        }
+
+        double returnDist = (yard.MAX_ROWS + yard.MAX_BAYS) / 2.0 * config.timeTravelUnit;
+        tables.columnCost.assign(yard.MAX_ROWS * yard.MAX_BAYS, 0.0);
+        for (int r = 0; r < yard.MAX_ROWS; ++r) {
+            for (int b = 0; b < yard.MAX_BAYS; ++b) {
+                // Distance to the Nearest Port (Optimistic Heuristic); ports sit at (-1, -1, p)
+                double minPortDist = 1e9;
+                for (int p = 1; p <= config.portCount; ++p) {
+                    minPortDist = std::fmin(minPortDist, getTravelTime(Coordinate(r, b, 0), Coordinate(-1, -1, p)));
+                }
+                tables.columnCost[yard.columnIndex(r, b)] = (config.timeHandle + minPortDist + config.timeHandle + config.timeProcess)
+                                                          + (config.timeHandle + returnDist + config.timeHandle);
+            }
+        }
+        tables.blockerCost = config.timeHandle + config.timeTravelUnit + config.timeHandle;
+
+        tables.frontWindow = 0;
+        tables.frontPerms.clear();
+        if (config.frontRule != FRONT_RULE_OFF && config.agvCount >= 2 && config.agvCount <= MAX_FRONT_AGVS) {
+            tables.frontWindow = std::max(0, std::min(config.frontWindow, MAX_FRONT_TASKS));
+            std::vector<int> perm(config.agvCount);
+            for (int i = 0; i < config.agvCount; ++i) perm[i] = i;
+            do {
+                tables.frontPerms.insert(tables.frontPerms.end(), perm.begin(), perm.end());
+            } while (std::next_permutation(perm.begin(), perm.end()));
+        }
+    }
+
+    // Contribution of one target: relocate its blockers, then retrieve / process / return it
+    static double targetUbalbCost(const YardSystem& yard, const SolveTables& tables, int targetId) {
+        Coordinate pos = yard.getBoxPosition(targetId);
+        if (pos.row == -1) return 0.0;
+        return tables.columnCost[yard.columnIndex(pos.row, pos.bay)] + (yard.getHeight(pos.row, pos.bay) - 1 - pos.tier) * tables.blockerCost;
+    }
+
+    // Full rescan (undivided); only used to seed the root, children are updated by delta
+    static double calculate3DUbalb(const YardSystem& yard, const SolveTables& tables, const std::vector<int>& seq, size_t fromIdx) {
+        double total = 0.0;
+        for (size_t i = fromIdx; i < seq.size(); ++i) total += targetUbalbCost(yard, tables, seq[i]);
+        return total;
+    }
+
+    // Targets with rank >= fromIdx in tiers [0, tierEnd) of one column
+    static int countRemainingTargets(const YardSystem& yard, int r, int b, int tierEnd, int fromIdx) {
+        if (yard.columnTargetCount(r, b) == 0) return 0;
+        int count = 0;
+        for (int t = 0; t < tierEnd; ++t) {
+            int rank = yard.futureRank(yard.getBoxAt(r, b, t));
+            if (rank >= fromIdx && rank != NO_RANK) count++;
+        }
+        return count;
+    }
+
+    // Top box of (r, b) leaves the column: every remaining target below it loses one blocker
+    static double ubalbAfterPickup(const YardSystem& yard, const SolveTables& tables, double ubalbSum, int r, int b, int fromIdx) {
+        return ubalbSum - countRemainingTargets(yard, r, b, yard.getHeight(r, b) - 1, fromIdx) * tables.blockerCost;
+    }
+
+    // A box is stacked on (r, b): every remaining target in the column gains one blocker
+    static double ubalbAfterDrop(const YardSystem& yard, const SolveTables& tables, double ubalbSum, int r, int b, int fromIdx) {
+        return ubalbSum + countRemainingTargets(yard, r, b, yard.getHeight(r, b), fromIdx) * tables.blockerCost;
+    }
+
+private:
+    // --- Expansion ---
+
+    // Sequence ranks for a yard of this solve, plus the destination index when it can cut the scan
+    // (0 < k < column count). Only with the index are the targets before `frontier` (already
+    // returned) treated as past boxes; without it the plans stay those of the full scan.
+    void attachSolveRanks(YardSystem& yard, const SolveTables& tables, int frontier) const {
+        bool indexed = config.destinationCandidates > 0 && config.destinationCandidates < yard.MAX_ROWS * yard.MAX_BAYS;
+        if (!indexed) {
+            yard.attachRanks(tables.rankOf);
+            return;
+        }
+        if (!yard.hasDestinationIndex()) yard.enableDestinationIndex();
+        yard.attachRanks(tables.rankOf, frontier);
+    }
+
+    // Columns a box from `src` (a port: (-1, -1, p)) may be put on, skipping skipColumn: every column
+    // with room, or the destinationCandidates best of the destination index (latest future target
+    // first, then nearest to src). Both are listed in row-major order, so ties break the same way and
+    // k >= the column count gives the full scan. One buffer per thread, valid until the next call.
+    const std::vector<int>& destinationColumns(const YardSystem& yard, Coordinate src, int skipColumn) const {
+        static thread_local std::vector<int> columns;
+        if (config.destinationCandidates > 0 && yard.hasDestinationIndex()) {
+            yard.bestDestinations(config.destinationCandidates, std::max(src.row, 0), std::max(src.bay, 0), skipColumn, columns);
+            std::sort(columns.begin(), columns.end());
+            return columns;
+        }
+        columns.clear();
+        for (int c = 0; c < yard.MAX_ROWS * yard.MAX_BAYS; ++c) {
+            if (c != skipColumn && yard.storage[c] < yard.MAX_TIERS) columns.push_back(c);
+        }
+        return columns;
+    }
+
+    // Stage 1: score every child of one parent without copying it.
+    // Case C hashes its child by modifying the parent yard in place and restoring it, so each
+    // parent must be expanded by exactly one thread at a time.
+    void expandNode(SearchNode& node, int parentIdx, int targetId, size_t seqIdx, int layer,
+                    const SolveTables& tables, std::vector<ExpandCandidate>& out) const {
+        ExpandCandidate cand;
+        cand.parent = parentIdx;
+        cand.frontPerm = 0;
+        Coordinate targetPos = node.yard.getBoxPosition(targetId);
+
+        // Case A: DONE
+        if (targetPos.row != -1 && node.isCurrentTargetRetrieved) {
+            cand.caseType = 0;
+            cand.g = node.g;
+            cand.h = node.h;
+            cand.f = node.f;
+            cand.ubalbSum = node.ubalbSum;
+            cand.yardHash = node.yard.stateHash;
+            cand.hash = nodeStateHash(node.yard.stateHash, node.agvs, -1, targetPos, 0.0, node.isCurrentTargetRetrieved);
+            out.push_back(cand);
+            return;
+        }
+
+        // Case B: RETURN (Port -> Yard)
+        if (targetPos.row == -1) {
+            int selectedPort = targetPos.tier;
+            Coordinate src(-1, -1, selectedPort);
+
+            for (int column : destinationColumns(node.yard, src, -1)) {
+                int r = column / node.yard.MAX_BAYS;
+                int b = column % node.yard.MAX_BAYS;
+                Coordinate dst(r, b, node.yard.getHeight(r, b));
+                double penalty = calculateReturnPenalty(node.yard, r, b, (int)seqIdx);
+
+                int bestAGV = -1;
+                double bestFinishTime = 1e9;
+                double bestStartTime = 0;
+                for (int i = 0; i < config.agvCount; ++i) {
+                    double travel = getTravelTime(node.agvs[i].currentPos, src);
+                    // Start time: AGV must be free AND Port must be done processing
+                    double start = std::fmax(node.agvs[i].availableTime, node.portsBusyTime[selectedPort]);
+                    double finish = start + travel + config.timeHandle + getTravelTime(src, dst) + config.timeHandle;
+                    if (finish < bestFinishTime) {
+                        bestFinishTime = finish;
+                        bestAGV = i;
+                        bestStartTime = start;
+                    }
+                }
+
+                cand.caseType = 1;
+                cand.src = src;
+                cand.dst = dst;
+                cand.agv = bestAGV;
+                cand.startTime = bestStartTime;
+                cand.finishTime = bestFinishTime;
+                cand.releaseTime = bestFinishTime;
+                cand.g = makespanWith(node, bestAGV, bestFinishTime);
+
+                // Only column (r, b) changes: its remaining targets gain one blocker
+                cand.ubalbSum = ubalbAfterDrop(node.yard, tables, node.ubalbSum, r, b, (int)seqIdx + 1);
+                cand.h = cand.ubalbSum / (double)config.agvCount;
+
+                cand.yardHash = node.yard.hashAfterReturn(targetId, r, b);
+                cand.hash = nodeStateHash(cand.yardHash, node.agvs, bestAGV, dst, bestFinishTime, true);
+
+                double noise = tieBreakNoise(seqIdx, layer, parentIdx, node.yard.columnIndex(r, b));
+                cand.f = cand.g + cand.h + penalty + noise;
+                out.push_back(cand);
+            }
+            return;
+        }
+
+        // Case C: RETRIEVE (Yard -> Port)
+        if (node.yard.isTop(targetId)) {
+            Coordinate src = node.yard.getBoxPosition(targetId);
+            int bestAGV = -1;
+            double bestFinishTime = 1e9;
+            double bestAGVFreeTime = 1e9;
+            double bestStartTime = 0;
+            int selectedPort = -1;
+
+            for (int i = 0; i < config.agvCount; ++i) {
+                double travel = getTravelTime(node.agvs[i].currentPos, src);
+                double start = std::fmax(node.agvs[i].availableTime, node.gridBusyTime[node.yard.columnIndex(src.row, src.bay)]);
+                double arrivalAtPort = start + travel + config.timeHandle + getTravelTime(src, Coordinate(-1, -1, 1));
+
+                // First port that is free on arrival, otherwise the one that frees up first
+                int p = -1;
+                for (int port = 1; port <= config.portCount; ++port) {
+                    if (node.portsBusyTime[port] <= arrivalAtPort) {
+                        p = port;
+                        break;
+                    }
+                }
+                if (p == -1) {
+                    double minPortFinishTime = 1e9;
+                    for (int port = 1; port <= config.portCount; ++port) {
+                        if (node.portsBusyTime[port] < minPortFinishTime) {
+                            minPortFinishTime = node.portsBusyTime[port];
+                            p = port;
+                        }
+                    }
+                }
+
+                double agvArrivalAtPort = start + travel + config.timeHandle + getTravelTime(src, Coordinate(-1, -1, p));
+                // Process Start = Max(AGV Arrival, Port Ready)
+                double processStart = std::fmax(agvArrivalAtPort, node.portsBusyTime[p]);
+                // AGV and port are decoupled: the AGV is free after the drop-off,
+                // the port only after processing
+                double agvFreeTime = processStart + config.timeHandle;
+                double portFinishTime = processStart + config.timeHandle + config.timeProcess;
+
+                // Minimize the port finish time (job done) for system throughput
+                if (portFinishTime < bestFinishTime) {
+                    bestFinishTime = portFinishTime;
+                    bestAGVFreeTime = agvFreeTime;
+                    bestAGV = i;
+                    bestStartTime = start;
+                    selectedPort = p;
+                }
+            }
+
+            cand.caseType = 2;
+            cand.src = src;
+            cand.dst = Coordinate(-1, -1, selectedPort);
+            cand.agv = bestAGV;
+            cand.startTime = bestStartTime;
+            cand.finishTime = bestFinishTime;
+            cand.releaseTime = bestAGVFreeTime;
+            cand.pickupTime = bestStartTime + getTravelTime(node.agvs[bestAGV].currentPos, src) + config.timeHandle;
+            cand.g = makespanWith(node, bestAGV, bestAGVFreeTime);
+
+            // The retrieved target drops out, the remaining targets below it lose one blocker
+            cand.ubalbSum = ubalbAfterPickup(node.yard, tables, node.ubalbSum - targetUbalbCost(node.yard, tables, targetId),
+                                             src.row, src.bay, (int)seqIdx + 1);
+            cand.h = cand.ubalbSum / (double)config.agvCount;
+            node.yard.moveToPort(targetId, selectedPort);
+            cand.yardHash = node.yard.stateHash;
+            cand.hash = nodeStateHash(node.yard.stateHash, node.agvs, bestAGV, cand.dst, bestAGVFreeTime, true);
+            node.yard.returnFromPort(targetId, src.row, src.bay);
+
+            cand.f = cand.g + cand.h + tieBreakNoise(seqIdx, layer, parentIdx, -1);
+            out.push_back(cand);
+            return;
+        }
+
+        // Case D: RESHUFFLE
+        std::vector<int> blockers = node.yard.getBlockingBoxes(targetId);
+        if (blockers.empty()) return;
+        int movingBoxId = blockers.back();
+        Coordinate src = node.yard.getBoxPosition(movingBoxId);
+
+        // The source column is the same for every destination
+        double pickedUbalb = ubalbAfterPickup(node.yard, tables, node.ubalbSum, src.row, src.bay, (int)seqIdx);
+        int movingRank = node.yard.futureRank(movingBoxId);
+        bool movingIsRemaining = movingRank >= (int)seqIdx && movingRank != NO_RANK;
+        if (movingIsRemaining) pickedUbalb -= tables.columnCost[node.yard.columnIndex(src.row, src.bay)];
+
+        for (int column : destinationColumns(node.yard, src, node.yard.columnIndex(src.row, src.bay))) {
+            int r = column / node.yard.MAX_BAYS;
+            int b = column % node.yard.MAX_BAYS;
+            Coordinate dst(r, b, node.yard.getHeight(r, b));
+            double penalty = calculateRILPenalty(node.yard, r, b, (int)seqIdx, movingBoxId);
+
+            int bestAGV = -1;
+            double bestFinishTime = 1e9;
+            double bestStartTime = 0;
+            for (int i = 0; i < config.agvCount; ++i) {
+                double travel = getTravelTime(node.agvs[i].currentPos, src);
+                double colReady = std::fmax(node.gridBusyTime[node.yard.columnIndex(src.row, src.bay)],
+                                            node.gridBusyTime[node.yard.columnIndex(r, b)]);
+                double start = std::fmax(node.agvs[i].availableTime, colReady);
+                double finish = start + travel + config.timeHandle + getTravelTime(src, dst) + config.timeHandle;
+                if (finish < bestFinishTime) {
+                    bestFinishTime = finish;
+                    bestAGV = i;
+                    bestStartTime = start;
+                }
+            }
+
+            cand.caseType = 3;
+            cand.src = src;
+            cand.dst = dst;
+            cand.agv = bestAGV;
+            cand.startTime = bestStartTime;
+            cand.finishTime = bestFinishTime;
+            cand.releaseTime = bestFinishTime;
+            cand.pickupTime = bestStartTime + getTravelTime(node.agvs[bestAGV].currentPos, src) + config.timeHandle;
+            cand.g = makespanWith(node, bestAGV, bestFinishTime);
+
+            cand.ubalbSum = ubalbAfterDrop(node.yard, tables, pickedUbalb, r, b, (int)seqIdx);
+            if (movingIsRemaining) cand.ubalbSum += tables.columnCost[node.yard.columnIndex(r, b)];
+            cand.h = cand.ubalbSum / (double)config.agvCount;
+
+            cand.yardHash = node.yard.hashAfterMove(src.row, src.bay, r, b);
+            cand.hash = nodeStateHash(cand.yardHash, node.agvs, bestAGV, dst, bestFinishTime, node.isCurrentTargetRetrieved);
+
+            cand.f = cand.g + cand.h + penalty + tieBreakNoise(seqIdx, layer, parentIdx, node.yard.columnIndex(r, b));
+            out.push_back(cand);
+        }
+    }
+
+    static void appendLog(SearchNode& node, std::vector<HistoryEntry>& arena, const ExpandCandidate& c, int containerId, int targetId) {
+        MissionLog log;
+        log.mission_no = node.historyLength + 1;
+        log.agv_id = c.agv;
+        log.type_code = (c.caseType == 1) ? 2 : (c.caseType == 2) ? 0 : 1;
+        log.batch_id = 20260117;
+        log.container_id = containerId;
+        log.related_target_id = targetId;
+        log.src = c.src;
+        log.dst = c.dst;
+        log.start_time_epoch = (long long)c.startTime + MISSION_EPOCH;
+        // RETRIEVE: mission END is when the AGV is released, not when the port finishes
+        log.end_time_epoch = (long long)c.releaseTime + MISSION_EPOCH;
+        log.makespan_snapshot = c.g;
+        log.mission_priority = 0;
+        log.mission_status = 0;
+
+        arena.push_back({log, node.historyTail});
+        node.historyTail = (int)arena.size() - 1;
+        node.historyLength += 1;
+    }
+
+    // Stage 2: apply a surviving candidate to a copy of its parent
+    void materializeCandidate(SearchNode& node, std::vector<HistoryEntry>* arena, const ExpandCandidate& c, int targetId,
+                              const SolveTables& tables) const {
+        if (c.caseType == 0) return;
+
+        FrontTask task = makeFrontTask(node, c);
+        int containerId = targetId;
+        if (c.caseType == 1) {
+            // The destination index ranks columns by future targets: the returned target is a past box now
+            if (node.yard.hasDestinationIndex()) node.yard.setRankFrontier(tables.rankOf[targetId] + 1);
+            node.yard.returnFromPort(targetId, c.dst.row, c.dst.bay);
+            node.isCurrentTargetRetrieved = true;
+            node.gridBusyTime[node.yard.columnIndex(c.dst.row, c.dst.bay)] = c.finishTime;
+        } else if (c.caseType == 2) {
+            node.yard.moveToPort(targetId, c.dst.tier);
+            node.isCurrentTargetRetrieved = true;
+            // The AGV is free earlier, the port stays busy longer
+            node.portsBusyTime[c.dst.tier] = c.finishTime;
+            node.gridBusyTime[node.yard.columnIndex(c.src.row, c.src.bay)] = c.pickupTime;
+        } else {
+            containerId = node.yard.getBoxAt(c.src.row, c.src.bay, c.src.tier);
+            node.yard.moveBox(c.src.row, c.src.bay, c.dst.row, c.dst.bay);
+            node.gridBusyTime[node.yard.columnIndex(c.src.row, c.src.bay)] = c.pickupTime;
+            node.gridBusyTime[node.yard.columnIndex(c.dst.row, c.dst.bay)] = c.finishTime;
+        }
+        node.agvs[c.agv].currentPos = c.dst;
+        node.agvs[c.agv].availableTime = c.releaseTime;
+        if (arena) appendLog(node, *arena, c, containerId, targetId);
+
+        if (node.frontCount == MAX_FRONT_TASKS) {
+            std::copy(node.frontTasks + 1, node.frontTasks + MAX_FRONT_TASKS, node.frontTasks);
+            node.frontCount--;
+        }
+        node.frontTasks[node.frontCount++] = task;
+        if (c.frontPerm > 0) applyFrontPerm(node, arena, tables, c.frontPerm);
+
+        node.g = c.g;
+        node.h = c.h;
+        node.ubalbSum = c.ubalbSum;
+        node.f = c.f;
+    }
+
+    // --- Front Rule (README §5) ---
+
+    static double resourceTime(const SearchNode& node, int key) {
+        return key >= 0 ? node.gridBusyTime[key] : node.portsBusyTime[-key];
+    }
+
+    // The mission of candidate c, as scheduled from node (its parent)
+    static FrontTask makeFrontTask(const SearchNode& node, const ExpandCandidate& c) {
+        FrontTask task;
+        task.caseType = c.caseType;
+        task.agv = c.agv;
+        task.src = c.src;
+        task.dst = c.dst;
+        task.srcKey = c.caseType == 1 ? -c.src.tier : node.yard.columnIndex(c.src.row, c.src.bay);
+        task.dstKey = c.caseType == 2 ? -c.dst.tier : node.yard.columnIndex(c.dst.row, c.dst.bay);
+        task.srcReady = resourceTime(node, task.srcKey);
+        task.dstReady = resourceTime(node, task.dstKey);
+        task.agvPos = node.agvs[c.agv].currentPos;
+        task.agvTime = node.agvs[c.agv].availableTime;
+        task.startTime = c.startTime;
+        task.releaseTime = c.releaseTime;
+        task.makespan = c.g;
+        return task;
+    }
+
+    // One mission of a front window re-timed on `agv` (moved to its destination), given the times its
+    // source / destination resources are busy until; with `writes`, records the times it sets.
+    // Returns its release time, its start time in `start`.
+    double replayFrontTask(const FrontTask& t, Agent& agv, double srcReady, double dstReady, FrontWrites* writes, double& start) const {
+        double travel = getTravelTime(agv.currentPos, t.src);
+        double release;
+        if (t.caseType == 2) {
+            start = std::fmax(agv.availableTime, srcReady);
+            double agvArrivalAtPort = start + travel + config.timeHandle + getTravelTime(t.src, t.dst);
+            double processStart = std::fmax(agvArrivalAtPort, dstReady);
+            release = processStart + config.timeHandle;
+            if (writes) {
+                writes->write(t.dstKey, processStart + config.timeHandle + config.timeProcess);
+                writes->write(t.srcKey, start + travel + config.timeHandle);
+            }
+        } else {
+            start = std::fmax(agv.availableTime, t.caseType == 3 ? std::fmax(srcReady, dstReady) : srcReady);
+            release = start + travel + config.timeHandle + getTravelTime(t.src, t.dst) + config.timeHandle;
+            if (writes) {
+                if (t.caseType == 3) writes->write(t.srcKey, start + travel + config.timeHandle);
+                writes->write(t.dstKey, release);
+            }
+        }
+        agv.currentPos = t.dst;
+        agv.availableTime = release;
+        return release;
+    }
+
+    // AGV states before a front window, from the states after it
+    void frontWindowStart(const FrontTask* tasks, int count, const Agent* after, Agent* before) const {
+        for (int i = 0; i < config.agvCount; ++i) before[i] = after[i];
+        for (int i = count - 1; i >= 0; --i) {
+            before[tasks[i].agv].currentPos = tasks[i].agvPos;
+            before[tasks[i].agv].availableTime = tasks[i].agvTime;
+        }
+    }
+
+    // Re-times a whole front window with mission i on AGV perm[tasks[i].agv]. Missions keep their
+    // order, destinations and ports, and wait for the columns / ports written by earlier ones, so a
+    // blocker is still picked up before what it blocks. Returns the AGVs' running time.
+    double replayFront(const FrontTask* tasks, int count, const int* perm, const Agent* before,
+                       Agent* agvsOut, FrontTask* tasksOut, FrontWrites& writes) const {
+        for (int i = 0; i < config.agvCount; ++i) agvsOut[i] = before[i];
+        double busy = 0;
+        for (int i = 0; i < count; ++i) {
+            const FrontTask& t = tasks[i];
+            Agent& agv = agvsOut[perm[t.agv]];
+            Agent prev = agv;
+            double srcReady = writes.read(t.srcKey, t.srcReady);
+            double dstReady = writes.read(t.dstKey, t.dstReady);
+            double start;
+            double release = replayFrontTask(t, agv, srcReady, dstReady, &writes, start);
+            busy += release - start;
+            if (!tasksOut) continue;
+
+            FrontTask& out = tasksOut[i];
+            out = t;
+            out.agv = perm[t.agv];
+            out.srcReady = srcReady;
+            out.dstReady = dstReady;
+            out.agvPos = prev.currentPos;
+            out.agvTime = prev.availableTime;
+            out.startTime = start;
+            out.releaseTime = release;
+            out.makespan = 0;
+            for (int a = 0; a < config.agvCount; ++a) out.makespan = std::fmax(out.makespan, agvsOut[a].availableTime);
+        }
+        return busy;
+    }
+
+    // f of the last child on the Front Rule shortlist (children above it are not checked)
+    double frontRuleCutoff(LayerWorkspace& ws, int beamSize, int width) const {
+        ws.scores.clear();
+        for (int k = 0; k < beamSize; ++k) {
+            for (const auto& c : ws.buffers[k]) ws.scores.push_back(c.f);
+        }
+        size_t shortlist = (size_t)config.frontShortlist * (size_t)width;
+        if (config.frontShortlist <= 0 || ws.scores.size() <= shortlist) return std::numeric_limits<double>::infinity();
+        std::nth_element(ws.scores.begin(), ws.scores.begin() + (shortlist - 1), ws.scores.end());
+        return ws.scores[shortlist - 1];
+    }
+
+    // Between expansion and top-K selection: re-time each shortlisted child's front window (the parent's
+    // latest missions + the child's own) under every relabeling of the AGVs. A child is dominated when one
+    // finishes with a smaller makespan, or the same makespan and less AGV running time.
+    // PRUNE drops dominated children (unless none would be left); REPLACE re-scores them with their
+    // best relabeling, which materializeCandidate then applies.
+    void applyFrontRule(const SearchNode& parent, const SolveTables& tables, std::vector<ExpandCandidate>& children,
+                        double cutoff, FrontRuleCounts* counts) const {
+        bool any = false;
+        for (const auto& c : children) any = any || (c.caseType != 0 && c.f <= cutoff);
+        if (!any) return;
+
+        const int agvCount = config.agvCount;
+        const int permCount = (int)tables.frontPerms.size() / agvCount;
+        const int keep = std::min(parent.frontCount, tables.frontWindow - 1);
+        const FrontTask* prefix = parent.frontTasks + parent.frontCount - keep;
+
+        // The parent's part of the window is the same for every child: re-time it once per relabeling.
+        // A child's own AGV starts from its state in the parent, so the window start does not depend on it.
+        Agent before[MAX_FRONT_AGVS];
+        frontWindowStart(prefix, keep, parent.agvs.data(), before);
+        Agent prefixAgvs[MAX_FRONT_PERMS][MAX_FRONT_AGVS];
+        FrontWrites prefixWrites[MAX_FRONT_PERMS];
+        double prefixBusy[MAX_FRONT_PERMS];
+        double prefixMakespan[MAX_FRONT_PERMS];  // lower bound on the makespan of any child under that relabeling
+        double parentBusy = 0;
+        for (int i = 0; i < keep; ++i) parentBusy += prefix[i].releaseTime - prefix[i].startTime;
+        for (int p = 1; p < permCount; ++p) {
+            prefixBusy[p] = replayFront(prefix, keep, &tables.frontPerms[p * agvCount], before, prefixAgvs[p], nullptr, prefixWrites[p]);
+            prefixMakespan[p] = 0;
+            for (int i = 0; i < agvCount; ++i) prefixMakespan[p] = std::fmax(prefixMakespan[p], prefixAgvs[p][i].availableTime);
+        }
+
+        Agent best[MAX_FRONT_AGVS];
+        std::vector<Agent> hashAgvs;
+        size_t dominated = 0;
+        for (auto& c : children) {
+            if (c.caseType == 0 || c.f > cutoff) continue;
+            FrontTask task = makeFrontTask(parent, c);
+
+            double bestG = c.g;
+            double bestBusy = parentBusy + (c.releaseTime - c.startTime);
+            for (int p = 1; p < permCount; ++p) {
+                if (prefixMakespan[p] > bestG + 1e-9) continue;
+                int agvId = tables.frontPerms[p * agvCount + c.agv];
+                Agent agv = prefixAgvs[p][agvId];
+                double start;
+                double release = replayFrontTask(task, agv, prefixWrites[p].read(task.srcKey, task.srcReady),
+                                                 prefixWrites[p].read(task.dstKey, task.dstReady), nullptr, start);
+                double g = release;
+                for (int i = 0; i < agvCount; ++i) {
+                    if (i != agvId) g = std::fmax(g, prefixAgvs[p][i].availableTime);
+                }
+                double busy = prefixBusy[p] + (release - start);
+                if (g < bestG - 1e-9 || (g <= bestG + 1e-9 && busy < bestBusy - 1e-9)) {
+                    c.frontPerm = p;
+                    bestG = g;
+                    bestBusy = busy;
+                    std::copy(prefixAgvs[p], prefixAgvs[p] + agvCount, best);
+                    best[agvId] = agv;
+                }
+            }
+            if (counts) counts->checked++;
+            if (c.frontPerm == 0) continue;
+            dominated++;
+
+            if (config.frontRule == FRONT_RULE_REPLACE) {
+                c.f += bestG - c.g;
+                c.g = bestG;
+                hashAgvs.assign(best, best + agvCount);
+                c.hash = nodeStateHash(c.yardHash, hashAgvs, -1, Coordinate(), 0.0, c.caseType != 3 || parent.isCurrentTargetRetrieved);
+                if (counts) counts->improved++;
+            }
+        }
+
+        if (config.frontRule == FRONT_RULE_PRUNE && dominated > 0) {
+            if (dominated < children.size()) {
+                children.erase(std::remove_if(children.begin(), children.end(),
+                                              [](const ExpandCandidate& c) { return c.frontPerm != 0; }), children.end());
+                if (counts) counts->pruned += (long long)dominated;
+            } else {
+                for (auto& c : children) c.frontPerm = 0;
+            }
+        }
+    }
+
+    // Applies relabeling `perm` to the front window of a just-materialized node: AGV states, the
+    // column / port times the window wrote, and (with an arena) its logged missions
+    void applyFrontPerm(SearchNode& node, std::vector<HistoryEntry>* arena, const SolveTables& tables, int perm) const {
+        int count = std::min(node.frontCount, tables.frontWindow);
+        FrontTask* window = node.frontTasks + node.frontCount - count;
+        FrontTask retimed[MAX_FRONT_TASKS];
+        Agent before[MAX_FRONT_AGVS];
+        Agent replayed[MAX_FRONT_AGVS];
+        FrontWrites writes;
+        frontWindowStart(window, count, node.agvs.data(), before);
+        replayFront(window, count, &tables.frontPerms[perm * config.agvCount], before, replayed, retimed, writes);
+
+        std::copy(retimed, retimed + count, window);
+        for (int i = 0; i < config.agvCount; ++i) {
+            node.agvs[i].currentPos = replayed[i].currentPos;
+            node.agvs[i].availableTime = replayed[i].availableTime;
+        }
+        for (int i = 0; i < writes.count; ++i) {
+            if (writes.keys[i] >= 0) node.gridBusyTime[writes.keys[i]] = writes.values[i];
+            else node.portsBusyTime[-writes.keys[i]] = writes.values[i];
+        }
+        if (!arena) return;
+
+        // The window's missions are the last `count` entries of the history: re-log them
+        int entries[MAX_FRONT_TASKS];
+        int tail = node.historyTail;
+        for (int i = count - 1; i >= 0; --i) {
+            entries[i] = tail;
+            tail = (*arena)[tail].prev;
+        }
+        for (int i = 0; i < count; ++i) {
+            MissionLog log = (*arena)[entries[i]].log;
+            log.agv_id = retimed[i].agv;
+            log.start_time_epoch = (long long)retimed[i].startTime + MISSION_EPOCH;
+            log.end_time_epoch = (long long)retimed[i].releaseTime + MISSION_EPOCH;
+            log.makespan_snapshot = retimed[i].makespan;
+            arena->push_back({log, tail});
+            tail = (int)arena->size() - 1;
+        }
+        node.historyTail = tail;
+    }
+
+    // --- Adaptive Width (README §4.5) ---
+
+    // Children within widthGap of the layer's best f, clamped to [minBeamWidth, maxWidth]:
+    // a layer whose best child clearly dominates keeps few nodes, a layer of close calls keeps many
+    int adaptiveLayerWidth(const std::vector<ExpandCandidate>& candidates, int maxWidth) const {
+        double best = std::numeric_limits<double>::infinity();
+        for (const auto& c : candidates) best = std::fmin(best, c.f);
+        double limit = best + config.widthGap;
+        int close = 0;
+        for (const auto& c : candidates) {
+            if (c.f <= limit && ++close >= maxWidth) break;
+        }
+        return std::max(std::min(close, maxWidth), std::min(config.minBeamWidth, maxWidth));
+    }
+
+    // Work done so far, to pace nodeBudget / timeBudget over the remaining layers
+    struct WidthPacer {
+        long long scored;          // candidates scored
+        long long expansions;      // parents expanded
+        int layers;
+        int targets;               // targets completed
+
+        WidthPacer() : scored(0), expansions(0), layers(0), targets(0) {}
+    };
+
+    // Largest width the remaining budget affords: the targets left are expected to take as many
+    // layers as the average so far, and each parent to cost as many candidates / seconds
+    int pacedWidth(const WidthPacer& pace, size_t remainingTargets, int layersIntoTarget, double elapsed, double timeBudget) const {
+        int width = config.beamWidth;
+        if (pace.expansions == 0) return width;
+        double layersPerTarget = (double)(pace.layers + 1) / (pace.targets + 1);
+        double remainingLayers = std::fmax(1.0, remainingTargets * layersPerTarget - layersIntoTarget);
+        if (config.nodeBudget > 0) {
+            double perParent = (double)pace.scored / pace.expansions;
+            double allowance = (double)(config.nodeBudget - pace.scored) / remainingLayers;
+            width = (int)std::fmin((double)width, allowance / perParent);
+        }
+        if (timeBudget > 0) {
+            double perParent = elapsed / pace.expansions;
+            double allowance = (timeBudget - elapsed) / remainingLayers;
+            width = (int)std::fmin((double)width, allowance / std::fmax(perParent, 1e-12));
+        }
+        return std::max(width, std::min(config.minBeamWidth, config.beamWidth));
+    }
+
+    // Indices of the beamWidth best candidates (ties broken by merge order),
+    // optionally keeping only the best candidate per child state hash
+    std::vector<int> selectTopCandidates(const std::vector<ExpandCandidate>& candidates, int k) const {
+        auto score = [](const ExpandCandidate& c) { return c.f; };
+        if (config.dedupStates) return selectTopKUnique(candidates, (size_t)k, score, [](const ExpandCandidate& c) { return c.hash; });
+        return selectTopK(candidates, (size_t)k, score);
+    }
+
+#ifdef _OPENMP
+    int expansionThreads() const {
+        return config.numThreads > 0 ? config.numThreads : omp_get_max_threads();
+    }
+#endif
+
+    // --- Beam Search ---
+
+    // Returns the final beam, best node first (empty on a dead end)
+    std::vector<SearchNode> run(const YardSystem& initialYard, const std::vector<int>& seq, const RunOptions& options) const {
+        SolveTables tables;
+        buildSolveTables(tables, initialYard, seq);
+
+        std::vector<SearchNode> currentBeam;
+        size_t startIdx = 0;
+        const Checkpoint* resumeFrom = (options.store && options.store->enabled()) ? options.store->findLongestPrefix(seq) : nullptr;
+        if (resumeFrom) {
+            // Continue after the shared prefix with this sequence's ranks
+            currentBeam = resumeFrom->state;
+            startIdx = resumeFrom->prefix.size();
+            for (auto& node : currentBeam) attachSolveRanks(node.yard, tables, (int)startIdx);
+            *options.resumed = true;
+        } else {
+            BBS_PHASE_TIMER(options.stats, PHASE_HEURISTIC);  // root: full 3D UBALB scan (+ the yard copy)
+            currentBeam.push_back(options.start ? makeRoot(*options.start, tables, seq) : makeRoot(initialYard, tables, seq));
+        }
+
+        LayerWorkspace workspace;
+        workspace.stats = options.stats;
+        const auto startTime = std::chrono::steady_clock::now();
+        long long scored = 0;
+        int width = config.beamWidth;
+        WidthPacer pace;
+        bool paced = config.adaptiveWidth && (config.nodeBudget > 0 || options.timeBudget > 0);
+
+        for (size_t seqIdx = startIdx; seqIdx < seq.size(); ++seqIdx) {
+            int targetId = seq[seqIdx];
+            bool targetCycleDone = false;
+            int expansionLimit = 0;
+
+            while (!targetCycleDone && expansionLimit < 40) {
+                expansionLimit++;
+
+                int layerWidth = width;
+                if (paced && width > 1) {
+                    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+                    layerWidth = pacedWidth(pace, seq.size() - seqIdx, expansionLimit - 1, elapsed, options.timeBudget);
+                }
+                long long parents = (long long)currentBeam.size();
+                size_t layerScored = expandLayer(currentBeam, workspace, targetId, seqIdx, expansionLimit, layerWidth,
+                                                 tables, options.history, targetCycleDone);
+                if (layerScored == 0) break;
+                scored += (long long)layerScored;
+                pace.scored += (long long)layerScored;
+                pace.expansions += parents;
+                pace.layers++;
+                if (options.widths) {
+                    LayerWidth w = {(int)seqIdx, expansionLimit, workspace.lastWidth, (long long)layerScored};
+                    options.widths->push_back(w);
+                }
+            }
+            pace.targets++;
+
+            if (currentBeam.empty()) return currentBeam;
+
+            // Anytime mode: report progress, collapse to a greedy finish once out of time
+            if (width > 1 && (options.timeBudget > 0 || options.progress)) {
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+                if (options.progress && !options.progress(options.progressCtx, elapsed, currentBeam[0].g, scored / std::fmax(elapsed, 1e-9))) width = 1;
+                if (options.timeBudget > 0 && elapsed >= options.timeBudget) width = 1;
+                if (width == 1) currentBeam.resize(1);
+            }
+
+            {
+                BBS_PHASE_TIMER(options.stats, PHASE_HEURISTIC);
+                for (auto& node : currentBeam) {
+                    // Moving on to seqIdx + 1: an unretrieved target leaves the remaining set
+                    if (!node.isCurrentTargetRetrieved) node.ubalbSum -= targetUbalbCost(node.yard, tables, targetId);
+                    node.isCurrentTargetRetrieved = false;
+                }
+            }
+
+            // Checkpoint after target seqIdx (the full sequence is the fitness cache's job)
+            if (options.saved && options.store->enabled() && config.checkpointStride > 0
+                && (seqIdx + 1) % config.checkpointStride == 0 && seqIdx + 1 < seq.size()) {
+                size_t bytes = sizeof(Checkpoint) + (seqIdx + 1) * sizeof(int);
+                for (const auto& node : currentBeam) bytes += nodeBytes(node);
+                options.saved->push_back({std::vector<int>(seq.begin(), seq.begin() + seqIdx + 1), currentBeam, bytes});
+            }
+        }
+        return currentBeam;
+    }
+};
+
+// GA objective (GeneticAlgorithm.h): makespan of a sequence under the solver's beam.
+// The GA already evaluates individuals in parallel, so each evaluation runs single-threaded.
+struct MakespanObjective {
+    typedef std::vector<SearchNode> State;
+
+    const YardSystem& yard;
+    const SearchNode* start;  // committed state to plan from (rolling horizon), nullptr = idle yard
+    MakespanSolver solver;
+
+    static SolverConfig serial(SolverConfig config) {
+        config.numThreads = 1;
+        return config;
+    }
+
+    MakespanObjective(const YardSystem& initialYard, const SolverConfig& config)
+        : yard(initialYard), start(nullptr), solver(serial(config)) {}
+
+    MakespanObjective(const SearchNode& state, const SolverConfig& config)
+        : yard(state.yard), start(&state), solver(serial(config)) {}
+
+    double evaluate(const std::vector<int>& seq) const {
+        return start ? solver.evaluate(*start, seq) : solver.evaluate(yard, seq);
+    }
+
+    double evaluateResumable(const std::vector<int>& seq, MakespanSolver::CheckpointStore& store,
+                             std::vector<MakespanSolver::Checkpoint>& saved, bool& resumed) const {
+        return start ? solver.evaluateResumable(*start, seq, store, saved, resumed)
+                     : solver.evaluateResumable(yard, seq, store, saved, resumed);
+    }
+};
+
+#endif // MAKESPANSOLVER_H
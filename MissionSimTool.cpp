@@ -0,0 +1,128 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#include "InstanceFile.h"
+#include "MissionSimulator.h"
+
+// Replays makespan mission logs (output_missions.csv) against their initial yard and reports
+// physical violations, achieved makespan, AGV utilization and port queueing (README §6.3).
+// Build: g++ -O2 -std=c++11 MissionSimTool.cpp -o mission_sim
+// Usage: ./mission_sim [--asap] [--agvs N] [--ports N] [--instance FILE | --yard CONFIG YARD] [missions.csv ...]
+// Several mission files are validated in one batch against the same yard; exit code 1 if any is invalid.
+
+static void printDetails(const SimulationReport& report) {
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Makespan       : " << report.makespan << " s (logged " << report.loggedMakespan << " s, ports done at "
+              << report.portMakespan << " s)" << std::endl;
+    if (report.maxTimeDeviation > 0) std::cout << "  Max Deviation  : " << report.maxTimeDeviation << " s" << std::endl;
+    for (size_t i = 0; i < report.agvs.size(); ++i) {
+        const AgvUsage& agv = report.agvs[i];
+        std::cout << "  AGV " << i << "          : " << agv.missions << " missions, busy " << agv.busyTime << " s ("
+                  << 100.0 * agv.utilization << "%), waiting " << agv.waitTime << " s" << std::endl;
+    }
+    for (size_t p = 1; p < report.ports.size(); ++p) {
+        const PortUsage& port = report.ports[p];
+        if (port.retrievals == 0) continue;
+        std::cout << "  Port " << p << "         : " << port.retrievals << " boxes, " << port.queued << " queued (total "
+                  << port.queueTime << " s, max " << port.maxQueueTime << " s), busy " << port.busyTime << " s, peak "
+                  << port.peakBoxes << " boxes" << std::endl;
+    }
+    for (const auto& v : report.violations) {
+        std::cout << "  ! mission " << v.missionNo << " @" << v.time << " s " << MissionSimulator::violationName(v.kind) << ": "
+                  << v.detail << std::endl;
+    }
+    if ((long long)report.violations.size() < report.totalViolations()) {
+        std::cout << "  ! ... " << report.totalViolations() - (long long)report.violations.size() << " more" << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+int main(int argc, char* argv[]) {
+    SolverConfig solverConfig;
+    SimulationConfig simConfig;
+    std::string instanceFile;
+    std::string configFile = "yard_config.csv";
+    std::string yardFile = "mock_yard.csv";
+    std::vector<std::string> missionFiles;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--asap") == 0) simConfig.followLoggedTimes = false;
+        else if (std::strcmp(argv[i], "--agvs") == 0 && i + 1 < argc) solverConfig.agvCount = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--ports") == 0 && i + 1 < argc) solverConfig.portCount = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--instance") == 0 && i + 1 < argc) instanceFile = argv[++i];
+        else if (std::strcmp(argv[i], "--yard") == 0 && i + 2 < argc) {
+            configFile = argv[++i];
+            yardFile = argv[++i];
+        } else if (argv[i][0] == '-') {
+            std::cerr << "Usage: " << argv[0] << " [--asap] [--agvs N] [--ports N] [--instance FILE | --yard CONFIG YARD] [missions.csv ...]"
+                      << std::endl;
+            return 1;
+        } else {
+            missionFiles.push_back(argv[i]);
+        }
+    }
+    if (missionFiles.empty()) missionFiles.push_back("output_missions.csv");
+
+    YardInstance instance;
+    if (!instanceFile.empty()) {
+        std::string error;
+        if (!InstanceFile::load(instanceFile, instance, error)) {
+            std::cerr << "Error: " << error << std::endl;
+            return 1;
+        }
+    } else {
+        instance.config = DataLoader::loadYardConfig(configFile);
+        std::vector<BoxSnapshot> boxes = DataLoader::loadYardSnapshot(yardFile);
+        if (instance.config.max_row == 0 || boxes.empty()) {
+            std::cerr << "Error: cannot load " << configFile << " / " << yardFile << std::endl;
+            return 1;
+        }
+        instance.yard = YardSystem(instance.config.max_row, instance.config.max_bay, instance.config.max_level, instance.config.total_boxes);
+        for (const auto& box : boxes) instance.yard.initBox(box.container_id, box.row, box.bay, box.level);
+    }
+    solverConfig.timeTravelUnit = instance.config.time_travel_unit;
+    solverConfig.timeHandle = instance.config.time_handle;
+    solverConfig.timeProcess = instance.config.time_process;
+
+    MissionSimulator simulator(instance.yard, solverConfig, simConfig);
+    std::cout << (simConfig.followLoggedTimes ? "Replay" : "ASAP") << " of " << missionFiles.size() << " plan(s), "
+              << solverConfig.agvCount << " AGVs, " << solverConfig.portCount << " ports" << std::endl;
+
+    size_t totalMissions = 0;
+    int invalid = 0;
+    double simSec = 0;
+    for (const auto& file : missionFiles) {
+        LoadReport loadReport;
+        std::vector<MissionLog> missions = MissionSimulator::loadMissions(file, &loadReport);
+        if (!loadReport.opened || !loadReport.errors.empty()) {
+            if (!loadReport.opened) std::cerr << "Error: cannot open " << file << std::endl;
+            DataLoader::printErrors(loadReport);
+            invalid++;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        SimulationReport report = simulator.run(missions);
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        simSec += sec;
+        totalMissions += report.missions;
+        if (!report.valid) invalid++;
+
+        std::cout << file << ": " << report.missions << " missions, " << (report.valid ? "valid" : "INVALID");
+        if (!report.valid) std::cout << " (" << report.totalViolations() << " violations)";
+        std::cout << ", makespan " << report.makespan << " (logged " << report.loggedMakespan << "), "
+                  << sec * 1000.0 << " ms" << std::endl;
+        if (missionFiles.size() == 1 || !report.valid) printDetails(report);
+    }
+
+    std::cout << "---------------------------------------------------" << std::endl;
+    std::cout << "Plans          : " << missionFiles.size() << " (" << invalid << " invalid)" << std::endl;
+    std::cout << "Missions       : " << totalMissions << " in " << simSec * 1000.0 << " ms ("
+              << std::fixed << std::setprecision(0) << (simSec > 0 ? totalMissions / simSec : 0.0) << " missions/s)" << std::endl;
+    return invalid > 0 ? 1 : 0;
+}
@@ -0,0 +1,546 @@
+#ifndef MISSIONSIMULATOR_H
+#define MISSIONSIMULATOR_H
+
+#include <vector>
+#include <string>
+#include <queue>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "DataLoader.h"
+#include "MakespanSolver.h"
+
+// ==========================================
+// Discrete-Event Mission Simulator (README §6.3)
+// Replays a timed mission plan (output_missions.csv or MissionLog vectors from MakespanSolver /
+// RollingPlanner) against the yard, the AGVs and the ports, independently of the beam's timing
+// code. Every mission becomes events: the AGV leaves, arrives at the source, finishes the
+// pick-up, arrives at the destination, finishes the drop-off (a port then processes the box).
+// Events are applied to the yard in time order, so a pick-up that happens before the box on
+// top of it was moved away is caught even when the plan lists the missions the other way round.
+//   Replay (default): each mission starts at its logged start_time (or when its AGV is free),
+//                     columns are not waited for, overlapping handling is reported.
+//   ASAP:             logged times are ignored; every column / port serves the missions that
+//                     use it in plan order, as soon as the AGVs get there (achievable makespan).
+// A port processes one box at a time; AGVs queue for it. Physical checks: the picked box is the
+// top of its column at the logged position, the destination column has room and the box lands
+// at the logged tier, a returned box is at its port and processed. A mission that fails its
+// pick-up still drives (empty), so later missions see the yard the plan actually leaves behind.
+// Times are solver seconds (epoch - MISSION_EPOCH), as SearchNode::g.
+// ==========================================
+
+enum SimViolationKind {
+    SIM_INVALID_MISSION = 0,  // AGV / port / position outside the configuration, or a bad type
+    SIM_NOT_ON_TOP,           // picked box is not on top of the logged column (or not there at all)
+    SIM_WRONG_TIER,           // box picked from / dropped at another tier than logged
+    SIM_COLUMN_FULL,          // destination column already at max_level
+    SIM_PORT_EMPTY,           // return of a box that is not at that port
+    SIM_COLUMN_CONFLICT,      // replay: two AGVs handling the same column at once
+    SIM_TIME_MISMATCH,        // replay: simulated start / end differs from the logged one
+    SIM_VIOLATION_KINDS
+};
+
+struct SimulationConfig {
+    bool followLoggedTimes;  // replay at the logged start times (false = ASAP in plan order)
+    double timeTolerance;    // seconds; logged times are truncated to whole seconds
+    size_t maxViolations;    // violations kept with details (all of them are counted)
+
+    SimulationConfig() : followLoggedTimes(true), timeTolerance(1.0), maxViolations(20) {}
+};
+
+struct SimViolation {
+    int kind;            // SimViolationKind
+    int missionNo;
+    double time;         // solver seconds
+    std::string detail;
+};
+
+struct AgvUsage {
+    int missions;
+    double busyTime;     // driving + handling
+    double waitTime;     // at a column / port that was not ready
+    double utilization;  // busyTime / makespan
+};
+
+struct PortUsage {
+    int retrievals;
+    int queued;          // retrievals that had to wait for the port
+    double queueTime;    // total AGV waiting time at the port
+    double maxQueueTime;
+    double busyTime;     // drop-off + processing
+    int peakBoxes;       // most boxes at the port at once (retrieved, not yet returned)
+};
+
+struct SimulationReport {
+    size_t missions;
+    size_t events;
+    bool valid;                               // no violation of any kind
+    long long violationCount[SIM_VIOLATION_KINDS];
+    std::vector<SimViolation> violations;     // the first SimulationConfig::maxViolations
+    double makespan;                          // last AGV release
+    double portMakespan;                      // last port done processing
+    double loggedMakespan;                    // latest logged end_time
+    double maxTimeDeviation;                  // replay: largest |simulated - logged| start / end
+    std::vector<AgvUsage> agvs;
+    std::vector<PortUsage> ports;             // indexed by port id (0 unused)
+
+    SimulationReport()
+        : missions(0), events(0), valid(true), makespan(0), portMakespan(0), loggedMakespan(0), maxTimeDeviation(0) {
+        std::fill(violationCount, violationCount + SIM_VIOLATION_KINDS, 0LL);
+    }
+
+    long long totalViolations() const {
+        long long total = 0;
+        for (int k = 0; k < SIM_VIOLATION_KINDS; ++k) total += violationCount[k];
+        return total;
+    }
+};
+
+class MissionSimulator {
+public:
+    // AGVs start idle at (0, 0) at time 0, like MakespanSolver::initialState; the yard needs no ranks
+    MissionSimulator(const YardSystem& initialYard, const SolverConfig& solverConfig,
+                     const SimulationConfig& simulationConfig = SimulationConfig())
+        : yard0(initialYard), config(solverConfig), sim(simulationConfig) {}
+
+    // Missions are executed per AGV in mission_no order; the vector itself may be in any order
+    SimulationReport run(const std::vector<MissionLog>& missions) const {
+        Replay replay(*this, missions);
+        replay.execute();
+        return replay.report;
+    }
+
+    static const char* violationName(int kind) {
+        static const char* names[SIM_VIOLATION_KINDS] = {"invalid_mission", "not_on_top", "wrong_tier", "column_full",
+                                                         "port_empty", "column_conflict", "time_mismatch"};
+        return kind >= 0 && kind < SIM_VIOLATION_KINDS ? names[kind] : "?";
+    }
+
+    // Makespan-mode output_missions.csv (README §6.2):
+    // mission_no,agv_id,mission_type,container_id,related_target_id,src_pos,dst_pos,start_time,end_time,makespan
+    // Positions are "(r;b;l)" or "work station (Port p)". Malformed rows are skipped and reported.
+    static std::vector<MissionLog> loadMissions(const std::string& filename, LoadReport* report = nullptr) {
+        static const char* fields[] = {"mission_no", "agv_id", "mission_type", "container_id", "related_target_id",
+                                       "src_pos", "dst_pos", "start_time", "end_time", "makespan"};
+        std::vector<MissionLog> missions;
+        LoadReport local;
+        LoadReport& rep = report ? *report : local;
+        rep = LoadReport();
+        rep.filename = filename;
+
+        MappedFile file(filename);
+        if (!file.isOpen()) return missions;
+        rep.opened = true;
+        if (file.begin() == file.end()) return missions;
+        const char* headerEnd = static_cast<const char*>(std::memchr(file.begin(), '\n', (size_t)(file.end() - file.begin())));
+        std::string header(file.begin(), headerEnd ? headerEnd : file.end());
+        if (header.compare(0, 17, "mission_no,agv_id") != 0) {
+            rep.errors.push_back({1, "not a makespan mission log (expected mission_no,agv_id,... columns)"});
+            if (!report) DataLoader::printErrors(rep);
+            return missions;
+        }
+        missions.reserve(DataLoader::countRows(file));
+
+        DataLoader::forEachRow(file, [&](CsvRow& row, int lineNo) {
+            MissionLog log;
+            std::string type, src, dst;
+            const char *first, *last;
+            double makespan;
+            if (!row.nextInt(log.mission_no) || !row.nextInt(log.agv_id) || !row.nextString(type)
+                || !row.nextInt(log.container_id) || !row.nextInt(log.related_target_id)
+                || !row.nextString(src) || !row.nextString(dst)
+                || !row.nextLong(log.start_time_epoch) || !row.nextLong(log.end_time_epoch)
+                || !row.next(first, last) || !CsvRow::parseDouble(first, last, makespan)) {
+                DataLoader::addFieldError(rep, lineNo, row, fields, 10, "a value");
+                return;
+            }
+            log.type_code = type == "target" ? 0 : type == "reshuffle" ? 1 : type == "return" ? 2 : -1;
+            if (log.type_code < 0) {
+                rep.errors.push_back({lineNo, "field 3 (mission_type): expected target / reshuffle / return, got '" + type + "'"});
+                return;
+            }
+            if (!parsePosition(src, log.src) || !parsePosition(dst, log.dst)) {
+                rep.errors.push_back({lineNo, "src_pos / dst_pos: expected (r;b;l) or work station (Port p)"});
+                return;
+            }
+            log.makespan_snapshot = makespan;
+            log.batch_id = 0;
+            log.mission_priority = 0;
+            log.mission_status = 0;
+            missions.push_back(log);
+        });
+
+        rep.rowsRead = missions.size();
+        if (!report) DataLoader::printErrors(rep);
+        return missions;
+    }
+
+    // "(r;b;l)" -> (r, b, l), "work station (Port p)" -> (-1, -1, p)
+    static bool parsePosition(const std::string& text, Coordinate& pos) {
+        const char* s = text.c_str();
+        char* end = nullptr;
+        if (text.compare(0, 19, "work station (Port ") == 0) {
+            long port = std::strtol(s + 19, &end, 10);
+            if (end == s + 19 || *end != ')') return false;
+            pos = Coordinate(-1, -1, (int)port);
+            return true;
+        }
+        if (*s != '(') return false;
+        long v[3];
+        const char* p = s + 1;
+        for (int i = 0; i < 3; ++i) {
+            v[i] = std::strtol(p, &end, 10);
+            if (end == p || *end != (i < 2 ? ';' : ')')) return false;
+            p = end + 1;
+        }
+        pos = Coordinate((int)v[0], (int)v[1], (int)v[2]);
+        return true;
+    }
+
+private:
+    enum EventKind {
+        EV_DISPATCH = 0,  // AGV free: start its next mission
+        EV_ARRIVE,        // AGV at the source (op 0) / destination (op 1), handling not started yet
+        EV_HANDLED        // pick-up (op 0) / drop-off (op 1) done
+    };
+
+    struct Event {
+        double time;
+        long long seq;    // FIFO among simultaneous events
+        int kind;
+        int id;           // AGV for EV_DISPATCH, mission index otherwise
+        int op;
+
+        bool operator>(const Event& other) const {
+            return time != other.time ? time > other.time : seq > other.seq;
+        }
+    };
+
+    // Per-mission simulation state
+    struct Trip {
+        int srcKey;          // resource at the source: column index, or portKey(port)
+        int dstKey;
+        int turn[2];         // ASAP: position in the source / destination resource's mission order
+        double arrived[2];   // first arrival at the source / destination (-1 = not yet)
+        double start;
+        bool blocked[2];     // ASAP: arrived before its turn, woken by release()
+        bool carrying;       // the pick-up succeeded
+    };
+
+    struct Replay {
+        const MissionSimulator& owner;
+        const std::vector<MissionLog>& logs;
+        YardSystem yard;
+        SimulationReport report;
+
+        std::vector<int> order;                     // mission indices by mission_no
+        std::vector<Trip> trips;
+        std::vector<std::vector<int>> agvQueue;     // mission indices, in execution order
+        std::vector<size_t> agvNext;
+        std::vector<Agent> agvs;
+        std::vector<double> busyUntil;              // per resource: handling (column) or processing (port) done
+        std::vector<std::vector<long long>> users;  // ASAP: per resource, (mission << 1 | op) in plan order
+        std::vector<size_t> cursor;                 // ASAP: whose turn it is
+        std::vector<double> readyAt;                // box id -> processed at its port
+        std::vector<int> portBoxes;
+        std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+        long long nextSeq;
+
+        Replay(const MissionSimulator& simulator, const std::vector<MissionLog>& missions)
+            : owner(simulator), logs(missions), yard(simulator.yard0), nextSeq(0) {}
+
+        const SolverConfig& cfg() const { return owner.config; }
+        int columns() const { return yard.MAX_ROWS * yard.MAX_BAYS; }
+        int portKey(int port) const { return columns() + port; }
+        bool isPortKey(int key) const { return key >= columns(); }
+
+        double travel(Coordinate a, Coordinate b) const {
+            int r1 = a.row == -1 ? 0 : a.row, b1 = a.bay == -1 ? 0 : a.bay;
+            int r2 = b.row == -1 ? 0 : b.row, b2 = b.bay == -1 ? 0 : b.bay;
+            return (std::abs(r1 - r2) + std::abs(b1 - b2)) * cfg().timeTravelUnit;
+        }
+
+        double logged(long long epoch) const { return (double)(epoch - MISSION_EPOCH); }
+
+        void push(double time, int kind, int id, int op) {
+            Event e = {time, nextSeq++, kind, id, op};
+            events.push(e);
+        }
+
+        void violation(int kind, int m, double time, const std::string& detail) {
+            report.valid = false;
+            report.violationCount[kind]++;
+            if (report.violations.size() < owner.sim.maxViolations) {
+                SimViolation v = {kind, m >= 0 ? logs[m].mission_no : 0, time, detail};
+                report.violations.push_back(v);
+            }
+        }
+
+        static std::string at(Coordinate c) {
+            if (c.row == -1) return "Port " + std::to_string(c.tier);
+            return "(" + std::to_string(c.row) + ";" + std::to_string(c.bay) + ";" + std::to_string(c.tier) + ")";
+        }
+
+        bool inYard(Coordinate c) const {
+            return c.row >= 0 && c.row < yard.MAX_ROWS && c.bay >= 0 && c.bay < yard.MAX_BAYS && c.tier >= 0 && c.tier < yard.MAX_TIERS;
+        }
+
+        bool isPort(Coordinate c) const { return c.row == -1 && c.tier >= 1 && c.tier <= cfg().portCount; }
+
+        // Source / destination shapes per type: target yard -> port, reshuffle yard -> yard, return port -> yard
+        bool validMission(const MissionLog& log) const {
+            if (log.agv_id < 0 || log.agv_id >= cfg().agvCount) return false;
+            if (log.container_id <= 0 || log.container_id >= yard.BOX_CAPACITY) return false;
+            switch (log.type_code) {
+            case 0: return inYard(log.src) && isPort(log.dst);
+            case 1: return inYard(log.src) && inYard(log.dst) && !(log.src.row == log.dst.row && log.src.bay == log.dst.bay);
+            case 2: return isPort(log.src) && inYard(log.dst);
+            default: return false;
+            }
+        }
+
+        int resourceKey(Coordinate c) const { return c.row == -1 ? portKey(c.tier) : yard.columnIndex(c.row, c.bay); }
+
+        void setup() {
+            int agvCount = cfg().agvCount;
+            report.missions = logs.size();
+            report.agvs.assign(agvCount, AgvUsage());
+            report.ports.assign(cfg().portCount + 1, PortUsage());
+            agvQueue.assign(agvCount, std::vector<int>());
+            agvNext.assign(agvCount, 0);
+            Agent idle;
+            idle.currentPos = Coordinate(0, 0, 0);
+            idle.availableTime = 0;
+            agvs.assign(agvCount, idle);
+            for (int i = 0; i < agvCount; ++i) agvs[i].id = i;
+
+            int resources = portKey(cfg().portCount) + 1;
+            busyUntil.assign(resources, 0.0);
+            cursor.assign(resources, 0);
+            if (!owner.sim.followLoggedTimes) users.assign(resources, std::vector<long long>());
+            readyAt.assign(yard.BOX_CAPACITY, 0.0);
+            portBoxes.assign(cfg().portCount + 1, 0);
+
+            order.resize(logs.size());
+            for (size_t i = 0; i < logs.size(); ++i) order[i] = (int)i;
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return logs[a].mission_no < logs[b].mission_no; });
+
+            trips.assign(logs.size(), Trip());
+            for (int m : order) {
+                const MissionLog& log = logs[m];
+                report.loggedMakespan = std::fmax(report.loggedMakespan, logged(log.end_time_epoch));
+                if (!validMission(log)) {
+                    violation(SIM_INVALID_MISSION, m, logged(log.start_time_epoch),
+                              "agv " + std::to_string(log.agv_id) + ", box " + std::to_string(log.container_id) + ", "
+                              + at(log.src) + " -> " + at(log.dst));
+                    continue;
+                }
+                Trip& trip = trips[m];
+                trip.srcKey = resourceKey(log.src);
+                trip.dstKey = resourceKey(log.dst);
+                trip.arrived[0] = trip.arrived[1] = -1;
+                trip.blocked[0] = trip.blocked[1] = false;
+                trip.carrying = false;
+                if (!owner.sim.followLoggedTimes) {
+                    trip.turn[0] = (int)users[trip.srcKey].size();
+                    users[trip.srcKey].push_back((long long)m << 1);
+                    trip.turn[1] = (int)users[trip.dstKey].size();
+                    users[trip.dstKey].push_back((long long)m << 1 | 1);
+                }
+                agvQueue[log.agv_id].push_back(m);
+            }
+        }
+
+        void execute() {
+            setup();
+            for (int i = 0; i < cfg().agvCount; ++i) push(0.0, EV_DISPATCH, i, 0);
+            while (!events.empty()) {
+                Event e = events.top();
+                events.pop();
+                report.events++;
+                if (e.kind == EV_DISPATCH) dispatch(e.id, e.time);
+                else if (e.kind == EV_ARRIVE) arrive(e.id, e.op, e.time);
+                else handled(e.id, e.op, e.time);
+            }
+            finish();
+        }
+
+        void dispatch(int agv, double now) {
+            if (agvNext[agv] >= agvQueue[agv].size()) return;
+            int m = agvQueue[agv][agvNext[agv]];
+            if (owner.sim.followLoggedTimes && logged(logs[m].start_time_epoch) > now) {
+                push(logged(logs[m].start_time_epoch), EV_DISPATCH, agv, 0);
+                return;
+            }
+            agvNext[agv]++;
+            Trip& trip = trips[m];
+            trip.start = now;
+            checkTime(m, "start", now, logged(logs[m].start_time_epoch));
+            double drive = travel(agvs[agv].currentPos, logs[m].src);
+            report.agvs[agv].busyTime += drive;
+            push(now + drive, EV_ARRIVE, m, 0);
+        }
+
+        // The AGV of mission m is at the source (op 0) or destination (op 1): start handling once the
+        // resource is ready, otherwise come back when it is
+        void arrive(int m, int op, double now) {
+            const MissionLog& log = logs[m];
+            Trip& trip = trips[m];
+            if (trip.arrived[op] < 0) trip.arrived[op] = now;
+            int key = op == 0 ? trip.srcKey : trip.dstKey;
+            bool port = isPortKey(key);
+
+            bool asap = !owner.sim.followLoggedTimes;
+            if (asap && (int)cursor[key] != trip.turn[op]) {
+                trip.blocked[op] = true;
+                return;
+            }
+            if (port && op == 0) {
+                // Return: the box must have been processed at this port
+                Coordinate pos = yard.getBoxPosition(log.container_id);
+                if (pos.row == -1 && pos.tier == log.src.tier && readyAt[log.container_id] > now) {
+                    push(readyAt[log.container_id], EV_ARRIVE, m, op);
+                    return;
+                }
+            } else if (port || asap) {
+                // One box processed at a time; ASAP columns also wait for the previous handling
+                if (busyUntil[key] > now) {
+                    push(busyUntil[key], EV_ARRIVE, m, op);
+                    return;
+                }
+            } else if (busyUntil[key] > now + owner.sim.timeTolerance) {
+                violation(SIM_COLUMN_CONFLICT, m, now, "column " + at(op == 0 ? log.src : log.dst) + " is handled until "
+                                                        + std::to_string(busyUntil[key]));
+            }
+
+            double waited = now - trip.arrived[op];
+            report.agvs[log.agv_id].waitTime += waited;
+            double handleEnd = now + cfg().timeHandle;
+            report.agvs[log.agv_id].busyTime += cfg().timeHandle;
+            if (port && op == 1) {
+                PortUsage& usage = report.ports[log.dst.tier];
+                usage.retrievals++;
+                usage.queueTime += waited;
+                usage.maxQueueTime = std::fmax(usage.maxQueueTime, waited);
+                if (waited > 0) usage.queued++;
+                usage.busyTime += cfg().timeHandle + cfg().timeProcess;
+                busyUntil[key] = handleEnd + cfg().timeProcess;
+                report.portMakespan = std::fmax(report.portMakespan, busyUntil[key]);
+            } else if (!port) {
+                busyUntil[key] = handleEnd;
+            }
+            push(handleEnd, EV_HANDLED, m, op);
+        }
+
+        void handled(int m, int op, double now) {
+            const MissionLog& log = logs[m];
+            Trip& trip = trips[m];
+            int key = op == 0 ? trip.srcKey : trip.dstKey;
+            if (op == 0) {
+                pickUp(m, now);
+                release(key, now);
+                double drive = travel(log.src, log.dst);
+                report.agvs[log.agv_id].busyTime += drive;
+                push(now + drive, EV_ARRIVE, m, 1);
+                return;
+            }
+
+            dropOff(m, now);
+            release(key, now);
+            Agent& agv = agvs[log.agv_id];
+            agv.currentPos = log.dst;
+            agv.availableTime = now;
+            report.agvs[log.agv_id].missions++;
+            report.makespan = std::fmax(report.makespan, now);
+            checkTime(m, "end", now, logged(log.end_time_epoch));
+            dispatch(log.agv_id, now);
+        }
+
+        // ASAP: the next mission in the resource's plan order may go ahead
+        void release(int key, double now) {
+            if (owner.sim.followLoggedTimes) return;
+            cursor[key]++;
+            if (cursor[key] < users[key].size()) {
+                long long next = users[key][cursor[key]];
+                int nm = (int)(next >> 1), nop = (int)(next & 1);
+                if (trips[nm].blocked[nop]) {
+                    trips[nm].blocked[nop] = false;
+                    push(now, EV_ARRIVE, nm, nop);
+                }
+            }
+        }
+
+        void pickUp(int m, double now) {
+            const MissionLog& log = logs[m];
+            Trip& trip = trips[m];
+            int box = log.container_id;
+            Coordinate pos = yard.getBoxPosition(box);
+            if (log.src.row == -1) {
+                if (pos.row != -1 || pos.tier != log.src.tier) {
+                    violation(SIM_PORT_EMPTY, m, now, "box " + std::to_string(box) + " is not at " + at(log.src));
+                    return;
+                }
+                yard.setLocation(box, -1, -1, -1);
+                portBoxes[log.src.tier]--;
+                trip.carrying = true;
+                return;
+            }
+            if (pos.row != log.src.row || pos.bay != log.src.bay || !yard.isTop(box)) {
+                int h = yard.getHeight(log.src.row, log.src.bay);
+                violation(SIM_NOT_ON_TOP, m, now, "box " + std::to_string(box) + " at " + (pos.tier == -1 ? std::string("nowhere") : at(pos))
+                                                  + ", top of " + at(log.src) + " is "
+                                                  + (h > 0 ? std::to_string(yard.getBoxAt(log.src.row, log.src.bay, h - 1)) : std::string("empty")));
+                return;
+            }
+            if (pos.tier != log.src.tier) {
+                violation(SIM_WRONG_TIER, m, now, "box " + std::to_string(box) + " picked from " + at(pos) + ", logged " + at(log.src));
+            }
+            yard.removeBox(box);
+            trip.carrying = true;
+        }
+
+        void dropOff(int m, double now) {
+            const MissionLog& log = logs[m];
+            int box = log.container_id;
+            if (!trips[m].carrying) return;
+            if (log.dst.row == -1) {
+                yard.setLocation(box, -1, -1, log.dst.tier);
+                readyAt[box] = busyUntil[trips[m].dstKey];
+                PortUsage& usage = report.ports[log.dst.tier];
+                usage.peakBoxes = std::max(usage.peakBoxes, ++portBoxes[log.dst.tier]);
+                return;
+            }
+            int h = yard.getHeight(log.dst.row, log.dst.bay);
+            if (h >= yard.MAX_TIERS) {
+                violation(SIM_COLUMN_FULL, m, now, "box " + std::to_string(box) + " dropped on full column " + at(log.dst));
+                return;  // the box is lost to the simulation
+            }
+            if (h != log.dst.tier) {
+                violation(SIM_WRONG_TIER, m, now, "box " + std::to_string(box) + " lands at tier " + std::to_string(h)
+                                                  + ", logged " + at(log.dst));
+            }
+            yard.initBox(box, log.dst.row, log.dst.bay, h);
+        }
+
+        void checkTime(int m, const char* what, double simulated, double loggedTime) {
+            if (!owner.sim.followLoggedTimes) return;
+            double deviation = std::fabs(simulated - loggedTime);
+            report.maxTimeDeviation = std::fmax(report.maxTimeDeviation, deviation);
+            if (deviation > owner.sim.timeTolerance) {
+                violation(SIM_TIME_MISMATCH, m, simulated, std::string(what) + " at " + std::to_string(simulated)
+                                                           + ", logged " + std::to_string(loggedTime));
+            }
+        }
+
+        void finish() {
+            for (auto& usage : report.agvs) usage.utilization = report.makespan > 0 ? usage.busyTime / report.makespan : 0.0;
+        }
+    };
+
+    YardSystem yard0;
+    SolverConfig config;
+    SimulationConfig sim;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef PREFIXCHECKPOINT_H
+#define PREFIXCHECKPOINT_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+
+// ==========================================
+// Prefix Checkpoint Store (GA evaluation resume)
+// Keeps the search state reached after the first k targets of evaluated sequences, so a
+// child that shares a prefix with an earlier individual only simulates its suffix.
+// Memory is bounded by a byte budget; the oldest checkpoints are evicted first (FIFO).
+// Lookups may run concurrently; insert() must only be called while no lookup is running
+// (the GA inserts at the generation barrier, in index order, to stay deterministic).
+// ==========================================
+template <typename State>
+class PrefixCheckpointStore {
+public:
+    struct Checkpoint {
+        std::vector<int> prefix; // The first k targets
+        State state;             // Search state after the k-th target
+        size_t bytes;            // Approximate footprint, charged against the budget
+    };
+
+    // budgetBytes == 0 disables the store
+    explicit PrefixCheckpointStore(size_t budgetBytes) : budget(budgetBytes) {}
+
+    PrefixCheckpointStore(const PrefixCheckpointStore&) = delete;
+    PrefixCheckpointStore& operator=(const PrefixCheckpointStore&) = delete;
+
+    bool enabled() const { return budget > 0; }
+
+    // Longest stored prefix of `sequence` (nullptr if none)
+    const Checkpoint* findLongestPrefix(const std::vector<int>& sequence) {
+        lookupCount.fetch_add(1, std::memory_order_relaxed);
+        totalTargets.fetch_add((long long)sequence.size(), std::memory_order_relaxed);
+        if (index.empty()) return nullptr;
+
+        std::vector<unsigned long long> keys(sequence.size());
+        unsigned long long h = PREFIX_SEED;
+        for (size_t k = 0; k < sequence.size(); ++k) keys[k] = h = extendHash(h, sequence[k]);
+
+        for (size_t k = sequence.size(); k > 0; --k) {
+            auto it = index.find(keys[k - 1]);
+            if (it == index.end()) continue;
+            const Checkpoint& cp = *it->second;
+            if (cp.prefix.size() == k && std::equal(cp.prefix.begin(), cp.prefix.end(), sequence.begin())) {
+                resumedCount.fetch_add(1, std::memory_order_relaxed);
+                skippedTargets.fetch_add((long long)k, std::memory_order_relaxed);
+                return &cp;
+            }
+        }
+        return nullptr;
+    }
+
+    void insert(Checkpoint cp) {
+        if (!enabled() || cp.bytes > budget) return;
+        unsigned long long key = PREFIX_SEED;
+        for (int id : cp.prefix) key = extendHash(key, id);
+        if (index.count(key)) return; // Keep the first state stored for this prefix
+
+        while (bytesUsed + cp.bytes > budget && !order.empty()) {
+            index.erase(order.front().first);
+            bytesUsed -= order.front().second.bytes;
+            order.pop_front();
+        }
+        bytesUsed += cp.bytes;
+        order.push_back(std::make_pair(key, std::move(cp)));
+        index[key] = &order.back().second;
+    }
+
+    size_t size() const { return order.size(); }
+    size_t memoryUsed() const { return bytesUsed; }
+    long long lookups() const { return lookupCount.load(); }
+    long long resumed() const { return resumedCount.load(); }
+    // Targets requested by all lookups, and how many of them were served from checkpoints
+    long long targetsRequested() const { return totalTargets.load(); }
+    long long targetsSkipped() const { return skippedTargets.load(); }
+
+private:
+    static const unsigned long long PREFIX_SEED = 1469598103934665603ULL;
+
+    static unsigned long long extendHash(unsigned long long h, int id) {
+        h ^= (unsigned long long)(unsigned int)id;
+        h *= 1099511628211ULL;
+        return h ^ (h >> 29);
+    }
+
+    size_t budget;
+    size_t bytesUsed = 0;
+    std::list<std::pair<unsigned long long, Checkpoint>> order; // Insertion order, for eviction
+    std::unordered_map<unsigned long long, const Checkpoint*> index;
+
+    std::atomic<long long> lookupCount{0};
+    std::atomic<long long> resumedCount{0};
+    std::atomic<long long> totalTargets{0};
+    std::atomic<long long> skippedTargets{0};
+};
+
+#endif // PREFIXCHECKPOINT_H
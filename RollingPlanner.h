@@ -0,0 +1,214 @@
+#ifndef ROLLINGPLANNER_H
+#define ROLLINGPLANNER_H
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#include "DataLoader.h"
+#include "MakespanSolver.h"
+#include "GeneticAlgorithm.h"
+
+// ==========================================
+// Rolling-Horizon Replanning (README §4.4)
+// Commands stream in during a shift (Command::create_time) together with AGV / port status
+// updates. Each replan() looks only at the next windowTargets released targets: the GA orders
+// them, the beam plans them from the committed state (yard + AGV / column / port busy times
+// after every mission handed out so far), and the first commitMissions missions are committed,
+// completed to the end of their target's cycle so the next window starts between two targets.
+// The next window continues from that committed state instead of the initial yard, and its GA
+// starts from the previous population (committed targets dropped, new arrivals appended).
+// The work of one replan depends on the window and the GA budget only, never on how long the
+// shift has been running: the planner keeps no mission history (committed missions are
+// returned to the caller) and no state beyond the current yard and the pending targets.
+// Times are epoch seconds like MissionLog (solver time 0 = MISSION_EPOCH).
+// ==========================================
+
+struct RollingConfig {
+    int windowTargets;     // released targets planned per replan
+    int commitMissions;    // missions committed per replan (completed to a target boundary)
+    int populationSize;    // GA over the window order (< 2 = keep arrival order)
+    int generations;       // GA generations per replan
+    double timeBudget;     // GA seconds per replan (0 = run `generations`)
+    int evalBeamWidth;     // beam width of the GA fitness evaluations (the plan uses SolverConfig::beamWidth)
+    int workers;           // GA fitness threads (0 = all hardware threads)
+    unsigned int seed;     // replan k runs its GA with seed + k
+
+    RollingConfig()
+        : windowTargets(12), commitMissions(8), populationSize(20), generations(10), timeBudget(0),
+          evalBeamWidth(5), workers(0), seed(1) {}
+};
+
+// Outcome of the last replan()
+struct ReplanReport {
+    int windowTargets;      // targets planned
+    int committedMissions;
+    int committedTargets;   // targets whose whole cycle was committed
+    int pendingTargets;     // targets still waiting (released or not) after the commit
+    double plannedMakespan; // end of the window plan, solver seconds
+    double latencySec;      // wall-clock time of the replan
+    bool deadEnd;           // released targets but no complete plan: nothing was committed
+
+    ReplanReport()
+        : windowTargets(0), committedMissions(0), committedTargets(0), pendingTargets(0), plannedMakespan(0),
+          latencySec(0), deadEnd(false) {}
+};
+
+class RollingPlanner {
+public:
+    // The yard must not have ranks attached; AGVs start idle at (0, 0), time 0
+    RollingPlanner(const YardSystem& initialYard, const SolverConfig& solverConfig, const RollingConfig& rollingConfig)
+        : config(rollingConfig), solver(solverConfig), replanCount(0), nextMissionNo(1) {
+        state = solver.initialState(initialYard);
+    }
+
+    // --- Events ---
+
+    // New command: only "target" commands whose box is in the yard are planned, each box once.
+    // It is released at create_time (epoch seconds); the window takes released targets in
+    // (create_time, cmd_priority) order. Returns false when the command was ignored.
+    bool addCommand(const Command& cmd) {
+        if (cmd.cmd_type != "target" || state.yard.getBoxPosition(cmd.parent_carrier_id).row == -1) return false;
+        for (const auto& p : pending) {
+            if (p.boxId == cmd.parent_carrier_id) return false;
+        }
+        PendingTarget target = {cmd.parent_carrier_id, (double)(cmd.create_time - MISSION_EPOCH), cmd.cmd_priority};
+        pending.insert(std::upper_bound(pending.begin(), pending.end(), target, releasedBefore), target);
+        return true;
+    }
+
+    // AGV status: position and the time it is free again (a breakdown, a manual job, ...)
+    void updateAgv(int agv, Coordinate pos, long long availableEpoch) {
+        if (agv < 0 || agv >= (int)state.agvs.size()) return;
+        state.agvs[agv].currentPos = pos;
+        state.agvs[agv].availableTime = (double)(availableEpoch - MISSION_EPOCH);
+    }
+
+    // Port status: busy until the given time (e.g. processing took longer than time_process)
+    void updatePort(int port, long long busyUntilEpoch) {
+        if (port < 1 || port >= (int)state.portsBusyTime.size()) return;
+        state.portsBusyTime[port] = (double)(busyUntilEpoch - MISSION_EPOCH);
+    }
+
+    // --- Planning ---
+
+    // Plans the window released by `nowEpoch` and returns the missions committed by this call
+    // (numbered on from the previous ones). No mission starts before nowEpoch.
+    std::vector<MissionLog> replan(long long nowEpoch) {
+        auto startClock = std::chrono::steady_clock::now();
+        report = ReplanReport();
+        std::vector<MissionLog> committed;
+
+        double now = (double)(nowEpoch - MISSION_EPOCH);
+        for (auto& agv : state.agvs) agv.availableTime = std::fmax(agv.availableTime, now);
+
+        std::vector<int> window;
+        for (size_t i = 0; i < pending.size() && (int)window.size() < config.windowTargets; ++i) {
+            if (pending[i].release > now) break;
+            window.push_back(pending[i].boxId);
+        }
+        report.windowTargets = (int)window.size();
+
+        if (!window.empty()) {
+            std::vector<MissionLog> plan = solver.solve(state, orderWindow(window));
+            report.deadEnd = plan.empty();
+            if (!plan.empty()) report.plannedMakespan = plan.back().makespan_snapshot;
+
+            // The first commitMissions missions, then on to the end of the cycle they stopped in
+            size_t n = 0;
+            int commitLimit = std::max(1, config.commitMissions);
+            while (n < plan.size() && ((int)n < commitLimit || plan[n - 1].type_code != 2)) {
+                MissionLog log = plan[n++];
+                solver.commitMission(state, log);
+                log.mission_no = nextMissionNo++;
+                committed.push_back(log);
+                if (log.type_code == 2) {
+                    removePending(log.related_target_id);
+                    report.committedTargets++;
+                }
+            }
+            report.committedMissions = (int)committed.size();
+            replanCount++;
+        }
+
+        report.pendingTargets = (int)pending.size();
+        report.latencySec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startClock).count();
+        return committed;
+    }
+
+    const ReplanReport& lastReport() const { return report; }
+    size_t pendingCount() const { return pending.size(); }
+    // Committed state: yard and the times AGVs / columns / ports are busy until (solver seconds)
+    const SearchNode& committedState() const { return state; }
+
+private:
+    struct PendingTarget {
+        int boxId;
+        double release;  // create_time, solver seconds
+        int priority;
+    };
+
+    static bool releasedBefore(const PendingTarget& a, const PendingTarget& b) {
+        return a.release < b.release || (a.release == b.release && a.priority < b.priority);
+    }
+
+    RollingConfig config;
+    MakespanSolver solver;
+    SearchNode state;
+    std::vector<PendingTarget> pending;         // arrival order
+    std::vector<std::vector<int>> population;   // last GA population, best first
+    int replanCount;
+    int nextMissionNo;
+    ReplanReport report;
+
+    void removePending(int boxId) {
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (pending[i].boxId == boxId) {
+                pending.erase(pending.begin() + i);
+                return;
+            }
+        }
+    }
+
+    // Retrieval order of the window: arrival order, or the GA's best warm-started from the last
+    // population (each individual keeps the relative order of its surviving targets)
+    std::vector<int> orderWindow(const std::vector<int>& window) {
+        if (config.populationSize < 2 || window.size() < 3) return window;
+
+        std::vector<char> inWindow(state.yard.BOX_CAPACITY, 0);
+        for (int id : window) inWindow[id] = 1;
+        std::vector<std::vector<int>> seeds(1, window);
+        for (const auto& previous : population) {
+            std::vector<int> seq;
+            std::vector<char> used(state.yard.BOX_CAPACITY, 0);
+            for (int id : previous) {
+                if (id >= 0 && id < (int)inWindow.size() && inWindow[id]) {
+                    seq.push_back(id);
+                    used[id] = 1;
+                }
+            }
+            for (int id : window) {
+                if (!used[id]) seq.push_back(id);
+            }
+            seeds.push_back(seq);
+        }
+
+        GAConfig gaConfig;
+        gaConfig.populationSize = config.populationSize;
+        gaConfig.maxGenerations = config.generations;
+        gaConfig.workers = config.workers;
+        gaConfig.verbose = false;
+        SolverConfig evalConfig = solver.getConfig();
+        evalConfig.beamWidth = config.evalBeamWidth;
+
+        MakespanObjective objective(state, evalConfig);
+        GeneticAlgorithm<MakespanObjective> ga(objective, window, config.seed + (unsigned int)replanCount, gaConfig);
+        ga.seedPopulation(seeds);
+        ga.setTimeBudget(config.timeBudget);
+        ga.solve();
+        population = ga.getPopulation();
+        return ga.getBestSequence();
+    }
+};
+
+#endif // ROLLINGPLANNER_H
@@ -0,0 +1,147 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <vector>
+#include <chrono>
+
+// ==========================================
+// Beam Search Instrumentation (optional)
+// Counts candidates per expansion case, nodes generated / kept per layer, time per phase,
+// bytes copied into new nodes and the Front Rule's checks / prunes / improvements.
+// Only compiled in with -DBBS_STATS: otherwise the BBS_STAT / BBS_PHASE_TIMER macros expand
+// to nothing and the search never touches the SearchStats object it is handed (it stays
+// zero, compiledIn() == false).
+// Phase times are summed over threads, so with parallel expansion they are CPU seconds.
+// ==========================================
+
+// Expansion cases; the values match MakespanSolver's ExpandCandidate::caseType
+enum SearchCase {
+    CASE_DONE = 0,       // A: current target finished
+    CASE_RETURN = 1,     // B: Port -> Yard
+    CASE_RETRIEVE = 2,   // C: Yard -> Port
+    CASE_RESHUFFLE = 3,  // D: blocker relocation
+    CASE_COUNT
+};
+
+enum SearchPhase {
+    PHASE_RETRIEVE = 0,  // retrieval candidates
+    PHASE_RESHUFFLE,     // blocker destinations (incl. their penalties and incremental heuristic)
+    PHASE_RETURN,        // return-slot search
+    PHASE_HEURISTIC,     // full heuristic scans (root / per-target bookkeeping)
+    PHASE_SELECT,        // top-K selection / sorting
+    PHASE_COPY,          // copying survivors into new nodes
+    PHASE_FRONT_RULE,    // Front Rule dominance checks (README §5)
+    PHASE_COUNT
+};
+
+struct LayerStats {
+    int seqIdx;           // target index in the sequence
+    int layer;            // expansion step within that target (1-based)
+    long long generated;  // candidates scored
+    long long kept;       // survivors materialized
+};
+
+struct SearchStats {
+    long long candidates[CASE_COUNT];
+    long long nodesGenerated;
+    long long nodesKept;
+    long long bytesCopied;
+    long long frontChecked;   // candidates whose front window was re-timed
+    long long frontPruned;    // dominated candidates dropped (FRONT_RULE_PRUNE)
+    long long frontImproved;  // candidates replaced by a better AGV assignment (FRONT_RULE_REPLACE)
+    double phaseSec[PHASE_COUNT];
+    std::vector<LayerStats> layers;
+
+    SearchStats() { reset(); }
+
+    void reset() {
+        for (int c = 0; c < CASE_COUNT; ++c) candidates[c] = 0;
+        for (int p = 0; p < PHASE_COUNT; ++p) phaseSec[p] = 0;
+        nodesGenerated = 0;
+        nodesKept = 0;
+        bytesCopied = 0;
+        frontChecked = 0;
+        frontPruned = 0;
+        frontImproved = 0;
+        layers.clear();
+    }
+
+    // One parent's expansion: its candidates all share one case
+    void addExpansion(int caseType, long long count, double sec) {
+        candidates[caseType] += count;
+        phaseSec[caseType == CASE_RESHUFFLE ? PHASE_RESHUFFLE : caseType == CASE_RETURN ? PHASE_RETURN : PHASE_RETRIEVE] += sec;
+    }
+
+    void addFrontRule(long long checked, long long pruned, long long improved, double sec) {
+        frontChecked += checked;
+        frontPruned += pruned;
+        frontImproved += improved;
+        phaseSec[PHASE_FRONT_RULE] += sec;
+    }
+
+    void addLayer(int seqIdx, int layer, long long generated, long long kept) {
+        nodesGenerated += generated;
+        nodesKept += kept;
+        layers.push_back({seqIdx, layer, generated, kept});
+    }
+
+    static bool compiledIn() {
+#ifdef BBS_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static const char* caseName(int c) {
+        static const char* names[CASE_COUNT] = {"done", "return", "retrieve", "reshuffle"};
+        return names[c];
+    }
+
+    static const char* phaseName(int p) {
+        static const char* names[PHASE_COUNT] = {"retrieve", "reshuffle", "return", "heuristic", "select", "copy", "front_rule"};
+        return names[p];
+    }
+};
+
+#ifdef BBS_STATS
+
+// Adds the lifetime of the enclosing scope to one phase (no-op on a null stats pointer)
+class PhaseTimer {
+public:
+    PhaseTimer(SearchStats* searchStats, int searchPhase)
+        : stats(searchStats), phase(searchPhase), start(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() {
+        if (stats) stats->phaseSec[phase] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    SearchStats* stats;
+    int phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define BBS_STATS_CONCAT_(a, b) a##b
+#define BBS_STATS_CONCAT(a, b) BBS_STATS_CONCAT_(a, b)
+#define BBS_STAT(...) do { __VA_ARGS__; } while (0)
+#define BBS_PHASE_TIMER(stats, phase) PhaseTimer BBS_STATS_CONCAT(bbsPhaseTimer, __LINE__)(stats, phase)
+// Runs stmt and adds its duration to *secOut (when secOut is not null)
+#define BBS_TIMED(secOut, stmt) do { \
+        std::chrono::steady_clock::time_point bbsTimedStart = std::chrono::steady_clock::now(); \
+        stmt; \
+        double* bbsTimedOut = (secOut); \
+        if (bbsTimedOut) *bbsTimedOut += std::chrono::duration<double>(std::chrono::steady_clock::now() - bbsTimedStart).count(); \
+    } while (0)
+
+#else
+
+#define BBS_STAT(...) do {} while (0)
+#define BBS_PHASE_TIMER(stats, phase) do {} while (0)
+#define BBS_TIMED(secOut, stmt) do { stmt; } while (0)
+
+#endif
+
+// A stats parameter that is only read through the hooks above is unused in the default build
+#define BBS_UNUSED(x) ((void)(x))
+
+#endif // SEARCHSTATS_H
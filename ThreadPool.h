@@ -0,0 +1,110 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+// ==========================================
+// Fixed-size worker pool for independent, read-only jobs (e.g. GA fitness evaluation).
+// Workers are created once and reused for every parallelFor() call.
+// ==========================================
+class ThreadPool {
+public:
+    // workers <= 0: use every hardware thread
+    explicit ThreadPool(int workers) {
+        if (workers <= 0) workers = (int)std::thread::hardware_concurrency();
+        if (workers <= 0) workers = 1;
+
+        // The calling thread also takes jobs, so spawn one fewer background worker
+        for (int i = 0; i < workers - 1; ++i) {
+            threads.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        wakeCv.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)threads.size() + 1; }
+
+    // Run job(i) for every i in [0, count) and block until all of them are done.
+    // Each index is executed exactly once; which thread runs it does not matter.
+    void parallelFor(int count, const std::function<void(int)>& job) {
+        if (count <= 0) return;
+        if (threads.empty() || count == 1) {
+            for (int i = 0; i < count; ++i) job(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            currentJob = &job;
+            jobCount = count;
+            nextIndex = 0;
+            pendingWorkers = (int)threads.size();
+            ++batchId;
+        }
+        wakeCv.notify_all();
+
+        runJobs();
+
+        // Wait until every worker has left this batch before `job` goes out of scope
+        std::unique_lock<std::mutex> lock(mtx);
+        doneCv.wait(lock, [this]() { return pendingWorkers == 0; });
+        currentJob = nullptr;
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+
+    const std::function<void(int)>* currentJob = nullptr;
+    int jobCount = 0;
+    std::atomic<int> nextIndex{0};
+    int pendingWorkers = 0;
+    long long batchId = 0;
+    bool stopping = false;
+
+    void runJobs() {
+        for (;;) {
+            int i = nextIndex.fetch_add(1);
+            if (i >= jobCount) break;
+            (*currentJob)(i);
+        }
+    }
+
+    void workerLoop() {
+        long long seenBatch = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                wakeCv.wait(lock, [&]() { return stopping || batchId != seenBatch; });
+                if (stopping) return;
+                seenBatch = batchId;
+            }
+
+            runJobs();
+
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (--pendingWorkers == 0) doneCv.notify_one();
+            }
+        }
+    }
+};
+
+#endif // THREADPOOL_H
@@ -4,6 +4,7 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <limits>
 
 // 座標結構
 struct Coordinate {
@@ -11,126 +12,477 @@ struct Coordinate {
     int bay; // y
     int tier; // z
 
+    Coordinate() : row(-1), bay(-1), tier(-1) {}
+    Coordinate(int r, int b, int t) : row(r), bay(b), tier(t) {}
+
     bool operator==(const Coordinate& other) const {
         return row == other.row && bay == other.bay && tier == other.tier;
     }
+
+    bool operator<(const Coordinate& other) const {
+        if (row != other.row) return row < other.row;
+        if (bay != other.bay) return bay < other.bay;
+        return tier < other.tier;
+    }
 };
 
+// Zobrist 鍵值: 每個 (格位, 箱號) 對應一個固定的 64-bit 亂數
+// 用 splitmix64 直接由 (slot, boxId) 算出，不需要存一張 R*B*T*N 的亂數表
+inline unsigned long long zobristKey(int slot, int boxId) {
+    unsigned long long x = ((unsigned long long)(unsigned int)slot << 32) | (unsigned int)boxId;
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// 不在取箱序列內 (或已取出並放回) 的箱子的 rank
+// 取有限值而非 INT_MAX：Makespan 求解器的 Lookahead 懲罰會直接計算 NO_RANK - seqIdx
+const int NO_RANK = 999999;
+
 class YardSystem {
 public: // <--- [關鍵修改] 將所有成員變數移到 public，讓 main.cpp 可以直接存取
-    
-    // 資料結構 1: 3D Matrix (空間查箱子)
-    std::vector<std::vector<std::vector<int>>> grid;
-
-    // 資料結構 2: Lookup Table (箱子查空間)
-    std::vector<Coordinate> boxLocations;
 
-    // 輔助結構: 每個柱子目前的高度 (Top Cache)
-    std::vector<std::vector<int>> tops;
+    // 單一連續記憶體 (Flat Storage)，複製節點時只需要一次配置 + memcpy
+    //   [0, R*B)                     : tops         每個柱子目前的高度 (Top Cache)
+    //   [R*B, R*B + R*B*T)           : grid         3D Matrix (空間查箱子)
+    //   [R*B + R*B*T, ... + R*B*T)   : minRank      每格記錄 tiers [0, t] 內最小的未來 rank (Stack-Min)
+    //   [..., ... + R*B*T)           : targetCount  每格記錄 tiers [0, t] 內未來目標的數量
+    //   [..., ... + 3*(N+1))         : boxLocations Lookup Table (箱子查空間, row/bay/tier)
+    // 在 Port 上的箱子: boxLocations = (-1, -1, port)
+    std::vector<int> storage;
 
     // 環境參數
     int MAX_ROWS;
     int MAX_BAYS;
     int MAX_TIERS;
+    int BOX_CAPACITY; // boxLocations 可容納的箱號數量 (totalBoxes + 1)
+
+    // 狀態雜湊 (Zobrist): 所有 (格位, 箱號) 鍵值的 XOR，每次搬動時增量更新
+    // 相同的堆場配置 (不論搬動順序) 會得到相同的 stateHash
+    unsigned long long stateHash;
+
+    // 目的地索引 (選用，enableDestinationIndex 後才有內容，見 README §4.6)
+    //   [0, R*B)      : order  依 destBefore 排序的柱號 (未滿在前，minRank 大到小，高度低到高；同鍵值的柱子順序不定)
+    //   [R*B, 2*R*B)  : slot   柱號 -> 在 order 中的位置
+    // 柱子的高度或 minRank 改變時，每跨過一段同鍵值的柱子只做一次二分搜尋 + 一次交換，
+    // 翻堆時可以直接取前 k 個目的地，不必掃過整個堆場
+    std::vector<int> destIndex;
+
+    // 箱號 -> 取箱序列 rank 的對照表 (由求解流程持有，所有複製出的堆場共用同一份)
+    // rank < rankFrontier 的箱子已經取出過，視為 NO_RANK
+    const int* rankOf;
+    int rankSize;
+    int rankFrontier;
 
     // [必要] 預設建構子 (為了解決 vector resize 錯誤)
-    YardSystem() : MAX_ROWS(0), MAX_BAYS(0), MAX_TIERS(0) {}
+    YardSystem() : MAX_ROWS(0), MAX_BAYS(0), MAX_TIERS(0), BOX_CAPACITY(0), stateHash(0),
+                   rankOf(nullptr), rankSize(0), rankFrontier(0) {}
 
     // 主要建構子
-    YardSystem(int rows, int bays, int tiers, int totalBoxes) 
-        : MAX_ROWS(rows), MAX_BAYS(bays), MAX_TIERS(tiers) {
-        
-        // 初始化 Matrix (全為 0)
-        grid.resize(rows, std::vector<std::vector<int>>(bays, std::vector<int>(tiers, 0)));
-        
-        // 初始化 Lookup Table (預留空間)
-        boxLocations.resize(totalBoxes + 1, {-1, -1, -1}); 
-        
-        // 初始化高度表
-        tops.resize(rows, std::vector<int>(bays, 0));
-    }
-
-    // 1. 初始化放置箱子
+    YardSystem(int rows, int bays, int tiers, int totalBoxes)
+        : MAX_ROWS(rows), MAX_BAYS(bays), MAX_TIERS(tiers), BOX_CAPACITY(totalBoxes + 1), stateHash(0),
+          rankOf(nullptr), rankSize(0), rankFrontier(0) {
+
+        // 初始化 Matrix 與高度表 (全為 0)
+        storage.assign(locationOffset() + 3 * BOX_CAPACITY, 0);
+
+        // 初始化 Lookup Table (-1 代表不在場內)
+        std::fill(storage.begin() + locationOffset(), storage.end(), -1);
+    }
+
+    // --- 記憶體配置 (Layout Helpers) ---
+
+    int columnIndex(int r, int b) const { return r * MAX_BAYS + b; }
+    int gridOffset() const { return MAX_ROWS * MAX_BAYS; }
+    int minRankOffset() const { return gridOffset() + MAX_ROWS * MAX_BAYS * MAX_TIERS; }
+    int targetCountOffset() const { return minRankOffset() + MAX_ROWS * MAX_BAYS * MAX_TIERS; }
+    int locationOffset() const { return targetCountOffset() + MAX_ROWS * MAX_BAYS * MAX_TIERS; }
+
+    int slotIndex(int r, int b, int t) const { return columnIndex(r, b) * MAX_TIERS + t; }
+    // Port 也佔用 Zobrist 格位 (接在所有堆場格位之後)
+    int portSlot(int portId) const { return MAX_ROWS * MAX_BAYS * MAX_TIERS + portId; }
+
+    int& heightRef(int r, int b) { return storage[columnIndex(r, b)]; }
+    int& cellRef(int r, int b, int t) { return storage[gridOffset() + slotIndex(r, b, t)]; }
+
+    void setLocation(int boxId, int r, int b, int t) {
+        int* loc = &storage[locationOffset() + 3 * boxId];
+        loc[0] = r; loc[1] = b; loc[2] = t;
+    }
+
+    // 新箱子疊到 (r, b, t) 時更新 minRank / targetCount；取走箱子時下方的值不變，所以不需要更新
+    void pushRank(int r, int b, int t, int boxId) {
+        int* minRank = &storage[minRankOffset()];
+        int* targets = &storage[targetCountOffset()];
+        int s = slotIndex(r, b, t);
+        int rank = futureRank(boxId);
+        minRank[s] = (t > 0) ? std::min(minRank[s - 1], rank) : rank;
+        targets[s] = ((t > 0) ? targets[s - 1] : 0) + (rank != NO_RANK ? 1 : 0);
+    }
+
+    // 柱子 (r, b) 的高度或 minRank 改變後，把它在目的地索引中往前 / 往後移到正確位置
+    void reindexColumn(int r, int b) {
+        if (destIndex.empty()) return;
+        int n = MAX_ROWS * MAX_BAYS;
+        int* order = destIndex.data();
+        int* slot = order + n;
+        int c = columnIndex(r, b);
+        int p = slot[c];
+        // 往前：和前一段同鍵值柱子的第一根交換 (該段整體後移一格)
+        while (p > 0 && destBefore(c, order[p - 1])) {
+            int key = order[p - 1];
+            int hi = p - 1, step = 1;  // 由近而遠倍增，再二分
+            while (hi - step >= 0 && !destBefore(order[hi - step], key)) {
+                hi -= step;
+                step *= 2;
+            }
+            int lo = std::max(0, hi - step + 1);
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (destBefore(order[mid], key)) lo = mid + 1;
+                else hi = mid;
+            }
+            swapDestinations(p, lo);
+            p = lo;
+        }
+        // 往後：和後一段同鍵值柱子的最後一根交換
+        while (p + 1 < n && destBefore(order[p + 1], c)) {
+            int key = order[p + 1];
+            int lo = p + 1, step = 1;
+            while (lo + step < n && !destBefore(key, order[lo + step])) {
+                lo += step;
+                step *= 2;
+            }
+            int hi = std::min(n - 1, lo + step - 1);
+            while (lo < hi) {
+                int mid = (lo + hi + 1) / 2;
+                if (destBefore(key, order[mid])) hi = mid - 1;
+                else lo = mid;
+            }
+            swapDestinations(p, lo);
+            p = lo;
+        }
+    }
+
+    void swapDestinations(int p, int q) {
+        int n = MAX_ROWS * MAX_BAYS;
+        std::swap(destIndex[p], destIndex[q]);
+        destIndex[n + destIndex[p]] = p;
+        destIndex[n + destIndex[q]] = q;
+    }
+
+    // bestDestinations 的一類 [begin, end) (代表柱 first)：取離來源最近的 need 個 (members > need)
+    void nearestInClass(int first, int members, int need, int srcRow, int srcBay, int skipColumn, int begin, int end,
+                        std::vector<int>& out) const {
+        int rank = columnMinRankAt(first);
+        size_t base = out.size();
+        int probes = 0;
+        int maxDist = std::max(srcRow, MAX_ROWS - 1 - srcRow) + std::max(srcBay, MAX_BAYS - 1 - srcBay);
+        // 第 d 圈依 row、bay 由小到大列舉，所以結果依 (距離, 柱號) 排序
+        for (int d = 0; d <= maxDist && probes <= members; ++d) {
+            for (int dr = -d; dr <= d; ++dr) {
+                int r = srcRow + dr;
+                if (r < 0 || r >= MAX_ROWS) continue;
+                int db = d - std::abs(dr);
+                for (int side = 0; side < (db == 0 ? 1 : 2); ++side) {
+                    int b = side == 0 ? srcBay - db : srcBay + db;
+                    if (b < 0 || b >= MAX_BAYS) continue;
+                    probes++;
+                    int c = columnIndex(r, b);
+                    if (c == skipColumn || storage[c] >= MAX_TIERS || columnMinRankAt(c) != rank) continue;
+                    out.push_back(c);
+                    if ((int)(out.size() - base) == need) return;
+                }
+            }
+        }
+
+        // 該類太稀疏：直接掃過整類，依 (距離, 柱號) 取前 need 個
+        out.resize(base);
+        for (int q = begin; q < end; ++q) {
+            if (destIndex[q] != skipColumn) out.push_back(destIndex[q]);
+        }
+        auto closer = [this, srcRow, srcBay](int a, int b) {
+            int da = std::abs(a / MAX_BAYS - srcRow) + std::abs(a % MAX_BAYS - srcBay);
+            int db = std::abs(b / MAX_BAYS - srcRow) + std::abs(b % MAX_BAYS - srcBay);
+            return da != db ? da < db : a < b;
+        };
+        std::partial_sort(out.begin() + base, out.begin() + base + need, out.end(), closer);
+        out.resize(base + need);
+    }
+
+    void rebuildDestinationIndex() {
+        int n = MAX_ROWS * MAX_BAYS;
+        int* order = destIndex.data();
+        for (int c = 0; c < n; ++c) order[c] = c;
+        std::sort(order, order + n, [this](int a, int b) { return destBefore(a, b) || (!destBefore(b, a) && a < b); });
+        for (int p = 0; p < n; ++p) order[n + order[p]] = p;
+    }
+
+    // --- Rank Summaries ---
+
+    // 掛上取箱序列的 rank 表，並重建所有柱子的 minRank
+    void attachRanks(const std::vector<int>& ranks, int frontier = 0) {
+        rankOf = ranks.data();
+        rankSize = (int)ranks.size();
+        rankFrontier = frontier;
+        for (int r = 0; r < MAX_ROWS; ++r) {
+            for (int b = 0; b < MAX_BAYS; ++b) {
+                for (int t = 0; t < getHeight(r, b); ++t) pushRank(r, b, t, getBoxAt(r, b, t));
+            }
+        }
+        if (!destIndex.empty()) rebuildDestinationIndex();
+    }
+
+    // --- Destination Index ---
+
+    // 啟用目的地索引 (複製堆場時一併複製)；之後每次搬動都會維護，掛上 rank 表時重建
+    void enableDestinationIndex() {
+        destIndex.assign(2 * MAX_ROWS * MAX_BAYS, 0);
+        rebuildDestinationIndex();
+    }
+
+    bool hasDestinationIndex() const { return !destIndex.empty(); }
+
+    // 排序後的柱號 (共 R*B 個)；已滿的柱子都在最後
+    const int* destinationOrder() const { return destIndex.data(); }
+
+    // 柱號版本的 columnMinRank (空柱為 NO_RANK)
+    int columnMinRankAt(int c) const {
+        int h = storage[c];
+        return h > 0 ? storage[minRankOffset() + c * MAX_TIERS + h - 1] : NO_RANK;
+    }
+
+    // 索引順序：未滿優先，最急需的未來目標越晚越好 (minRank 大)，再來是較低的柱子
+    bool destBefore(int a, int b) const {
+        bool fullA = storage[a] >= MAX_TIERS, fullB = storage[b] >= MAX_TIERS;
+        if (fullA != fullB) return fullB;
+        int rankA = columnMinRankAt(a), rankB = columnMinRankAt(b);
+        if (rankA != rankB) return rankA > rankB;
+        return storage[a] < storage[b];
+    }
+
+    // 與 order[p] 同一類 (同樣已滿或同樣的 minRank) 的最後位置 + 1，二分搜尋
+    int destinationClassEnd(int p) const {
+        const int* order = destIndex.data();
+        int n = MAX_ROWS * MAX_BAYS;
+        bool full = storage[order[p]] >= MAX_TIERS;
+        int rank = columnMinRankAt(order[p]);
+        int lo = p + 1, hi = n;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            int c = order[mid];
+            if ((storage[c] >= MAX_TIERS) == full && columnMinRankAt(c) == rank) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // 最佳的 k 個目的地柱號 (不含 skipColumn，放進 out)：依索引順序一類一類取 (minRank 大的類在前)，
+    // 整類放得下就全取 (依柱號)，否則取該類中離 (srcRow, srcBay) 最近的 (曼哈頓距離，同距離依柱號)。
+    // 類內的最近鄰先由來源向外一圈一圈找，找超過該類大小仍不夠時改成掃過該類，
+    // 所以花費與 k (及該類的密度) 成正比，而不是整個堆場
+    void bestDestinations(int k, int srcRow, int srcBay, int skipColumn, std::vector<int>& out) const {
+        out.clear();
+        const int* order = destIndex.data();
+        int n = MAX_ROWS * MAX_BAYS;
+        int p = 0;
+        while (p < n && (int)out.size() < k && storage[order[p]] < MAX_TIERS) {
+            int end = destinationClassEnd(p);
+            int members = end - p;
+            if (skipColumn >= 0 && destIndex[n + skipColumn] >= p && destIndex[n + skipColumn] < end) members--;
+            int need = k - (int)out.size();
+            if (members <= need) {
+                size_t base = out.size();
+                for (int q = p; q < end; ++q) {
+                    if (order[q] != skipColumn) out.push_back(order[q]);
+                }
+                std::sort(out.begin() + base, out.end());  // 類內依柱號，結果與索引的維護順序無關
+            } else {
+                nearestInClass(order[p], members, need, srcRow, srcBay, skipColumn, p, end, out);
+            }
+            p = end;
+        }
+    }
+
+    // 推進到下一個目標；rank 介於舊/新 frontier 之間的箱子此時必須不在場內
+    // (它們在放回時才會以 NO_RANK 重新疊上)
+    void setRankFrontier(int frontier) { rankFrontier = frontier; }
+
+    // 1. 初始化放置箱子 (已掛上 rank 表時，只能疊在柱子頂端)
     void initBox(int boxId, int r, int b, int t) {
         if (r >= MAX_ROWS || b >= MAX_BAYS || t >= MAX_TIERS) return;
 
-        grid[r][b][t] = boxId;
-        boxLocations[boxId] = {r, b, t};
-        
-        if (t + 1 > tops[r][b]) {
-            tops[r][b] = t + 1;
+        cellRef(r, b, t) = boxId;
+        if (boxId >= BOX_CAPACITY) {
+            // boxLocations 是最後一段，直接加長不影響其他區段
+            BOX_CAPACITY = boxId + 1;
+            storage.resize(locationOffset() + 3 * BOX_CAPACITY, -1);
+        }
+        setLocation(boxId, r, b, t);
+        stateHash ^= zobristKey(slotIndex(r, b, t), boxId);
+        if (rankOf) pushRank(r, b, t, boxId);
+
+        if (t + 1 > heightRef(r, b)) {
+            heightRef(r, b) = t + 1;
         }
+        reindexColumn(r, b);
     }
 
     // 2. 移動箱子
     bool moveBox(int fromRow, int fromBay, int toRow, int toBay) {
-        if (tops[fromRow][fromBay] == 0) return false;
-        if (tops[toRow][toBay] >= MAX_TIERS) return false;
+        if (getHeight(fromRow, fromBay) == 0) return false;
+        if (getHeight(toRow, toBay) >= MAX_TIERS) return false;
 
-        int currentTier = tops[fromRow][fromBay] - 1; 
-        int boxId = grid[fromRow][fromBay][currentTier];
-        int targetTier = tops[toRow][toBay];
+        int currentTier = getHeight(fromRow, fromBay) - 1;
+        int boxId = getBoxAt(fromRow, fromBay, currentTier);
+        int targetTier = getHeight(toRow, toBay);
 
         // 更新 Matrix
-        grid[fromRow][fromBay][currentTier] = 0; 
-        grid[toRow][toBay][targetTier] = boxId; 
+        cellRef(fromRow, fromBay, currentTier) = 0;
+        cellRef(toRow, toBay, targetTier) = boxId;
 
         // 更新 Lookup Table
-        boxLocations[boxId] = {toRow, toBay, targetTier};
+        setLocation(boxId, toRow, toBay, targetTier);
+
+        // 更新狀態雜湊
+        stateHash ^= zobristKey(slotIndex(fromRow, fromBay, currentTier), boxId)
+                   ^ zobristKey(slotIndex(toRow, toBay, targetTier), boxId);
 
         // 更新高度緩存
-        tops[fromRow][fromBay]--;
-        tops[toRow][toBay]++;
+        heightRef(fromRow, fromBay)--;
+        heightRef(toRow, toBay)++;
+
+        // 更新 minRank (只有目的柱的新頂層需要)
+        if (rankOf) pushRank(toRow, toBay, targetTier, boxId);
+        reindexColumn(fromRow, fromBay);
+        reindexColumn(toRow, toBay);
 
         return true;
     }
 
     // 3. 取出箱子
     void removeBox(int boxId) {
-        if (boxId >= boxLocations.size()) return;
-        Coordinate pos = boxLocations[boxId];
+        if (boxId >= BOX_CAPACITY) return;
+        Coordinate pos = getBoxPosition(boxId);
         if (pos.row == -1) return;
 
-        if (pos.tier == tops[pos.row][pos.bay] - 1) {
-            grid[pos.row][pos.bay][pos.tier] = 0;
-            tops[pos.row][pos.bay]--;
-            boxLocations[boxId] = {-1, -1, -1}; 
+        if (pos.tier == getHeight(pos.row, pos.bay) - 1) {
+            cellRef(pos.row, pos.bay, pos.tier) = 0;
+            heightRef(pos.row, pos.bay)--;
+            setLocation(boxId, -1, -1, -1);
+            stateHash ^= zobristKey(slotIndex(pos.row, pos.bay, pos.tier), boxId);
+            reindexColumn(pos.row, pos.bay);
         }
     }
 
+    // 4. 取出箱子送到 Port (箱子暫存在 Port 上，之後可以放回)
+    void moveToPort(int boxId, int portId) {
+        if (boxId >= BOX_CAPACITY) return;
+        Coordinate pos = getBoxPosition(boxId);
+        if (pos.row == -1) return;
+
+        cellRef(pos.row, pos.bay, pos.tier) = 0;
+        heightRef(pos.row, pos.bay)--;
+        setLocation(boxId, -1, -1, portId);
+        stateHash ^= zobristKey(slotIndex(pos.row, pos.bay, pos.tier), boxId) ^ zobristKey(portSlot(portId), boxId);
+        reindexColumn(pos.row, pos.bay);
+    }
+
+    // 5. 由 Port 放回 (r, b) 的頂端
+    void returnFromPort(int boxId, int r, int b) {
+        if (boxId >= BOX_CAPACITY) return;
+        if (!canReceiveBox(r, b)) return;
+
+        int t = getHeight(r, b);
+        Coordinate pos = getBoxPosition(boxId);
+        if (pos.row == -1 && pos.tier != -1) stateHash ^= zobristKey(portSlot(pos.tier), boxId);
+        stateHash ^= zobristKey(slotIndex(r, b, t), boxId);
+
+        cellRef(r, b, t) = boxId;
+        heightRef(r, b)++;
+        setLocation(boxId, r, b, t);
+        if (rankOf) pushRank(r, b, t, boxId);
+        reindexColumn(r, b);
+    }
+
     // --- 查詢 API ---
 
+    // 搬動後的狀態雜湊 (不修改堆場)，用於候選步驟去重
+    unsigned long long hashAfterMove(int fromRow, int fromBay, int toRow, int toBay) const {
+        int currentTier = getHeight(fromRow, fromBay) - 1;
+        int boxId = getBoxAt(fromRow, fromBay, currentTier);
+        return stateHash ^ zobristKey(slotIndex(fromRow, fromBay, currentTier), boxId)
+                         ^ zobristKey(slotIndex(toRow, toBay, getHeight(toRow, toBay)), boxId);
+    }
+
+    // 由 Port 放回 (r, b) 後的狀態雜湊 (不修改堆場)
+    unsigned long long hashAfterReturn(int boxId, int r, int b) const {
+        Coordinate pos = getBoxPosition(boxId);
+        unsigned long long hash = stateHash ^ zobristKey(slotIndex(r, b, getHeight(r, b)), boxId);
+        if (pos.row == -1 && pos.tier != -1) hash ^= zobristKey(portSlot(pos.tier), boxId);
+        return hash;
+    }
+
+    // 尚未取出之目標的 rank (非目標或已取出: NO_RANK)
+    int futureRank(int boxId) const {
+        if (!rankOf || boxId < 0 || boxId >= rankSize) return NO_RANK;
+        int rank = rankOf[boxId];
+        return rank >= rankFrontier ? rank : NO_RANK;
+    }
+
+    // 柱子內最急需的未來目標 rank (O(1)，沒有則為 NO_RANK)
+    int columnMinRank(int r, int b) const {
+        int h = getHeight(r, b);
+        return h > 0 ? storage[minRankOffset() + slotIndex(r, b, h - 1)] : NO_RANK;
+    }
+
+    // 柱子內尚未取出的目標數量 (O(1))
+    int columnTargetCount(int r, int b) const {
+        int h = getHeight(r, b);
+        return h > 0 ? storage[targetCountOffset() + slotIndex(r, b, h - 1)] : 0;
+    }
+
+    int getHeight(int r, int b) const {
+        return storage[columnIndex(r, b)];
+    }
+
+    int getBoxAt(int r, int b, int t) const {
+        return storage[gridOffset() + slotIndex(r, b, t)];
+    }
+
     Coordinate getBoxPosition(int boxId) const {
-        if (boxId >= boxLocations.size()) return {-1, -1, -1};
-        return boxLocations[boxId];
+        if (boxId >= BOX_CAPACITY) return {-1, -1, -1};
+        const int* loc = &storage[locationOffset() + 3 * boxId];
+        return {loc[0], loc[1], loc[2]};
     }
 
     std::vector<int> getBlockingBoxes(int boxId) const {
         std::vector<int> blockers;
-        if (boxId >= boxLocations.size()) return blockers;
-        
-        Coordinate pos = boxLocations[boxId];
-        if (pos.row == -1) return blockers; 
+        if (boxId >= BOX_CAPACITY) return blockers;
+
+        Coordinate pos = getBoxPosition(boxId);
+        if (pos.row == -1) return blockers;
 
-        int topTier = tops[pos.row][pos.bay];
+        int topTier = getHeight(pos.row, pos.bay);
         for (int t = pos.tier + 1; t < topTier; ++t) {
-            blockers.push_back(grid[pos.row][pos.bay][t]);
+            blockers.push_back(getBoxAt(pos.row, pos.bay, t));
         }
         return blockers;
     }
 
     bool canReceiveBox(int r, int b) const {
         if (r < 0 || r >= MAX_ROWS || b < 0 || b >= MAX_BAYS) return false;
-        return tops[r][b] < MAX_TIERS;
+        return getHeight(r, b) < MAX_TIERS;
     }
 
     bool isTop(int boxId) const {
-        if (boxId >= boxLocations.size()) return false;
-        Coordinate pos = boxLocations[boxId];
+        if (boxId >= BOX_CAPACITY) return false;
+        Coordinate pos = getBoxPosition(boxId);
         if (pos.row == -1) return true; // 視為已取出
 
-        return pos.tier == (tops[pos.row][pos.bay] - 1);
+        return pos.tier == (getHeight(pos.row, pos.bay) - 1);
     }
 };
 
-#endif // YARDSYSTEM_H
\ No newline at end of file
+#endif // YARDSYSTEM_H
@@ -4,206 +4,31 @@
 # cython: cdivision=True
 
 from libcpp.vector cimport vector
+from libcpp cimport bool
 from libcpp.string cimport string
-from libcpp.unordered_map cimport unordered_map
-from libcpp.algorithm cimport sort
-from libcpp.cmath cimport abs
-from cython.parallel import prange
-from libc.math cimport fmax, fmin
-from libc.stdlib cimport rand, RAND_MAX, srand
 import time
 
 # ==========================================
-# 1. C++ Struct Definitions
+# 1. Shared C++ Core (MakespanSolver.h)
 # ==========================================
-cdef extern from *:
-    """
-    #include <vector>
-    #include <string>
-    #include <cmath>
-    #include <algorithm>
-    #include <iostream>
-    #include <limits>
-    #include <random>
-
-    struct Coordinate {
-        int row;
-        int bay;
-        int tier;
-        
-        Coordinate() : row(-1), bay(-1), tier(-1) {}
-        Coordinate(int r, int b, int t) : row(r), bay(b), tier(t) {}
-
-        bool operator==(const Coordinate& other) const {
-            return row == other.row && bay == other.bay && tier == other.tier;
-        }
-        
-        bool operator<(const Coordinate& other) const {
-            if (row != other.row) return row < other.row;
-            if (bay != other.bay) return bay < other.bay;
-            return tier < other.tier;
-        }
-    };
-
-    Coordinate make_coord(int r, int b, int t) {
-        return Coordinate(r, b, t);
-    }
-
-    struct Agent {
-        int id;
-        Coordinate currentPos;
-        double availableTime;
-    };
-
-    struct MissionLog {
-        int mission_no;
-        int agv_id;
-        int batch_id;
-        int container_id;
-        int related_target_id;
-        Coordinate src;
-        Coordinate dst;
-        int mission_priority;
-        long long start_time_epoch;
-        long long end_time_epoch;
-        double makespan_snapshot;
-        int type_code; 
-        int mission_status; 
-        
-        bool operator<(const MissionLog& other) const {
-            return start_time_epoch < other.start_time_epoch;
-        }
-    };
-
-    struct YardSystem {
-        int MAX_ROWS;
-        int MAX_BAYS;
-        int MAX_TIERS;
-        std::vector<std::vector<std::vector<int>>> grid;
-        std::vector<Coordinate> boxLocations;
-        std::vector<std::vector<int>> tops;
-
-        void init(int r, int b, int t, int total) {
-            MAX_ROWS = r; MAX_BAYS = b; MAX_TIERS = t;
-            grid.resize(r, std::vector<std::vector<int>>(b, std::vector<int>(t, 0)));
-            boxLocations.resize(total + 1, Coordinate(-1, -1, -1));
-            tops.resize(r, std::vector<int>(b, 0));
-        }
-
-        void initBox(int id, int r, int b, int t) {
-            if(r >= MAX_ROWS || b >= MAX_BAYS || t >= MAX_TIERS) return;
-            grid[r][b][t] = id;
-            if (id >= boxLocations.size()) boxLocations.resize(id + 1, Coordinate(-1, -1, -1));
-            boxLocations[id] = Coordinate(r, b, t);
-            if (t + 1 > tops[r][b]) tops[r][b] = t + 1;
-        }
-
-        void moveToPort(int id, int port_id) {
-            if (id >= boxLocations.size()) return;
-            Coordinate pos = boxLocations[id];
-            if (pos.row != -1) {
-                grid[pos.row][pos.bay][pos.tier] = 0;
-                tops[pos.row][pos.bay]--;
-                boxLocations[id] = Coordinate(-1, -1, port_id);
-            }
-        }
-        
-        void returnFromPort(int id, int r, int b) {
-            if (id >= boxLocations.size()) return;
-            if (r < 0 || r >= MAX_ROWS || b < 0 || b >= MAX_BAYS) return;
-            
-            int t = tops[r][b];
-            if (t >= MAX_TIERS) return;
-
-            grid[r][b][t] = id;
-            tops[r][b]++;
-            boxLocations[id] = Coordinate(r, b, t);
-        }
-
-        void removeBox(int id) {
-            if (id >= boxLocations.size()) return;
-            Coordinate pos = boxLocations[id];
-            if (pos.row != -1) {
-                grid[pos.row][pos.bay][pos.tier] = 0;
-                tops[pos.row][pos.bay]--;
-                boxLocations[id] = Coordinate(-1, -1, -1);
-            }
-        }
-
-        void moveBox(int r1, int b1, int r2, int b2) {
-            int t1 = tops[r1][b1] - 1;
-            int id = grid[r1][b1][t1];
-            int t2 = tops[r2][b2];
-            
-            grid[r1][b1][t1] = 0;
-            grid[r2][b2][t2] = id;
-            boxLocations[id] = Coordinate(r2, b2, t2);
-            tops[r1][b1]--;
-            tops[r2][b2]++;
-        }
-        
-        Coordinate getBoxPosition(int id) const {
-            if (id >= boxLocations.size()) return Coordinate(-1, -1, -1);
-            return boxLocations[id];
-        }
-
-        bool isTop(int id) const {
-            if (id >= boxLocations.size()) return false;
-            Coordinate pos = boxLocations[id];
-            if (pos.row == -1) return true; 
-            return pos.tier == (tops[pos.row][pos.bay] - 1);
-        }
-
-        std::vector<int> getBlockingBoxes(int id) const {
-            std::vector<int> blockers;
-            if (id >= boxLocations.size()) return blockers;
-            Coordinate pos = boxLocations[id];
-            if (pos.row == -1) return blockers;
-            for (int t = pos.tier + 1; t < tops[pos.row][pos.bay]; ++t) {
-                blockers.push_back(grid[pos.row][pos.bay][t]);
-            }
-            return blockers;
-        }
-
-        bool canReceiveBox(int r, int b) const {
-             if (r < 0 || r >= MAX_ROWS || b < 0 || b >= MAX_BAYS) return false;
-             return tops[r][b] < MAX_TIERS;
-        }
-    };
-
-    struct SearchNode {
-        YardSystem yard;
-        std::vector<Agent> agvs;
-        double g;
-        double h;
-        double f;
-        std::vector<std::vector<double>> gridBusyTime;
-        
-        std::vector<double> portsBusyTime; 
-
-        bool isCurrentTargetRetrieved;
-        std::vector<MissionLog> history;
-        
-        bool operator<(const SearchNode& other) const {
-            return f < other.f;
-        }
-    };
-    """
-    
+cdef extern from "MakespanSolver.h" nogil:
     cdef cppclass Coordinate:
         int row
         int bay
         int tier
-        bint operator==(const Coordinate&)
-
-    Coordinate make_coord(int r, int b, int t) nogil
+        Coordinate()
+        Coordinate(int r, int b, int t)
 
-    cdef struct Agent:
-        int id
-        Coordinate currentPos
-        double availableTime
+    cdef cppclass YardSystem:
+        int MAX_ROWS
+        int MAX_BAYS
+        int MAX_TIERS
+        YardSystem()
+        YardSystem(int rows, int bays, int tiers, int totalBoxes)
+        void initBox(int id, int r, int b, int t)
+        Coordinate getBoxPosition(int boxId)
 
-    cdef struct MissionLog:
+    cdef cppclass MissionLog:
         int mission_no
         int agv_id
         int batch_id
@@ -211,43 +36,231 @@ cdef extern from *:
         int related_target_id
         Coordinate src
         Coordinate dst
-        int mission_priority
         long long start_time_epoch
         long long end_time_epoch
         double makespan_snapshot
         int type_code
+        int mission_priority
         int mission_status
 
-    cdef cppclass YardSystem:
-        int MAX_ROWS
-        int MAX_BAYS
-        int MAX_TIERS
-        vector[vector[vector[int]]] grid
-        vector[vector[int]] tops
-        void init(int r, int b, int t, int total) nogil
-        void initBox(int id, int r, int b, int t) nogil
-        void removeBox(int id) nogil
-        void moveToPort(int id, int port_id) nogil 
-        void returnFromPort(int id, int r, int b) nogil 
-        void moveBox(int r1, int b1, int r2, int b2) nogil
-        Coordinate getBoxPosition(int id) nogil
-        bint isTop(int id) nogil
-        vector[int] getBlockingBoxes(int id) nogil
-        bint canReceiveBox(int r, int b) nogil
-
-    cdef cppclass SearchNode:
+    cdef cppclass SolverConfig:
+        double timeTravelUnit
+        double timeHandle
+        double timeProcess
+        int agvCount
+        int beamWidth
+        int portCount
+        int numThreads
+        bool dedupStates
+        int frontRule
+        int frontWindow
+        int frontShortlist
+        bool adaptiveWidth
+        int minBeamWidth
+        double widthGap
+        long long nodeBudget
+        int destinationCandidates
+        double penaltyBlocking
+        double penaltyLookahead
+
+    cdef int FRONT_RULE_OFF
+    cdef int FRONT_RULE_PRUNE
+    cdef int FRONT_RULE_REPLACE
+
+    cdef cppclass LayerWidth:
+        int seqIdx
+        int layer
+        int width
+        long long candidates
+
+    ctypedef int (*SolveProgressFn)(void* ctx, double elapsed, double best, double evalsPerSec) noexcept nogil
+
+    cdef cppclass MakespanSolver:
+        MakespanSolver(const SolverConfig& config)
+        vector[MissionLog] solve(const YardSystem& initialYard, const vector[int]& seq,
+                                 double timeBudget, SolveProgressFn progress, void* progressCtx,
+                                 SearchStats* stats, vector[LayerWidth]* widths)
+
+    cdef cppclass MakespanObjective:
+        MakespanObjective(const YardSystem& initialYard, const SolverConfig& config)
+
+cdef extern from "SearchStats.h" nogil:
+    cdef int CASE_COUNT
+    cdef int PHASE_COUNT
+
+    cdef cppclass LayerStats:
+        int seqIdx
+        int layer
+        long long generated
+        long long kept
+
+    cdef cppclass SearchStats:
+        long long candidates[4]
+        long long nodesGenerated
+        long long nodesKept
+        long long bytesCopied
+        long long frontChecked
+        long long frontPruned
+        long long frontImproved
+        double phaseSec[7]
+        vector[LayerStats] layers
+        void reset()
+        @staticmethod
+        bool compiledIn()
+        @staticmethod
+        const char* caseName(int c)
+        @staticmethod
+        const char* phaseName(int p)
+
+cdef extern from "InstanceFile.h" nogil:
+    cdef cppclass Coord3D:
+        int row
+        int bay
+        int level
+
+    cdef cppclass Command:
+        int cmd_no
+        string cmd_type
+        int cmd_priority
+        int parent_carrier_id
+        Coord3D dest_position
+        long long create_time
+
+    cdef cppclass BoxSnapshot:
+        int container_id
+        int row
+        int bay
+        int level
+
+    cdef cppclass YardConfig:
+        int max_row
+        int max_bay
+        int max_level
+        int total_boxes
+        double time_travel_unit
+        double time_handle
+        double time_process
+
+    cdef cppclass YardInstance:
+        YardConfig config
         YardSystem yard
-        vector[Agent] agvs
-        double g
-        double h
-        double f
-        vector[vector[double]] gridBusyTime
-        vector[double] portsBusyTime
-        bint isCurrentTargetRetrieved
-        vector[MissionLog] history
-        bint operator<(const SearchNode&) const
-
-    void printf(const char *format, ...) nogil
+        vector[Command] commands
+
+    cdef cppclass InstanceFile:
+        @staticmethod
+        bool load(const string& filename, YardInstance& out, string& error)
+        @staticmethod
+        vector[BoxSnapshot] snapshot(const YardSystem& yard)
+
+cdef extern from "GeneticAlgorithm.h" nogil:
+    cdef cppclass GAConfig:
+        int populationSize
+        int maxGenerations
+        double mutationRate
+        double crossoverRate
+        int islandCount
+        int migrationInterval
+        int migrantCount
+        int workers
+        size_t fitnessCacheSize
+        size_t checkpointBudgetMB
+        bool verbose
+
+    cdef cppclass GeneticAlgorithm[T]:
+        GeneticAlgorithm(const T& objective, const vector[int]& targets, unsigned int seed, const GAConfig& config)
+        void setTimeBudget(double seconds)
+        void solve()
+        vector[int] getBestSequence()
+        double getBestFitness()
+        int getWorkerCount()
+        long long getCacheHits()
+        long long getCacheMisses()
+
+cdef extern from "RollingPlanner.h" nogil:
+    cdef cppclass RollingConfig:
+        int windowTargets
+        int commitMissions
+        int populationSize
+        int generations
+        double timeBudget
+        int evalBeamWidth
+        int workers
+        unsigned int seed
+
+    cdef cppclass ReplanReport:
+        int windowTargets
+        int committedMissions
+        int committedTargets
+        int pendingTargets
+        double plannedMakespan
+        double latencySec
+        bool deadEnd
+
+    cdef cppclass RollingPlanner:
+        RollingPlanner(const YardSystem& initialYard, const SolverConfig& solverConfig, const RollingConfig& rollingConfig)
+        bool addCommand(const Command& cmd)
+        void updateAgv(int agv, Coordinate pos, long long availableEpoch)
+        void updatePort(int port, long long busyUntilEpoch)
+        vector[MissionLog] replan(long long nowEpoch)
+        const ReplanReport& lastReport()
+        size_t pendingCount()
+
+cdef extern from "MissionSimulator.h" nogil:
+    cdef int SIM_VIOLATION_KINDS
+
+    cdef cppclass ParseError:
+        int line
+        string message
+
+    cdef cppclass LoadReport:
+        bool opened
+        vector[ParseError] errors
+
+    cdef cppclass SimulationConfig:
+        bool followLoggedTimes
+        double timeTolerance
+        size_t maxViolations
+
+    cdef cppclass SimViolation:
+        int kind
+        int missionNo
+        double time
+        string detail
+
+    cdef cppclass AgvUsage:
+        int missions
+        double busyTime
+        double waitTime
+        double utilization
+
+    cdef cppclass PortUsage:
+        int retrievals
+        int queued
+        double queueTime
+        double maxQueueTime
+        double busyTime
+        int peakBoxes
+
+    cdef cppclass SimulationReport:
+        size_t missions
+        size_t events
+        bool valid
+        long long violationCount[7]
+        vector[SimViolation] violations
+        double makespan
+        double portMakespan
+        double loggedMakespan
+        double maxTimeDeviation
+        vector[AgvUsage] agvs
+        vector[PortUsage] ports
+
+    cdef cppclass MissionSimulator:
+        MissionSimulator(const YardSystem& initialYard, const SolverConfig& solverConfig, const SimulationConfig& simulationConfig)
+        SimulationReport run(const vector[MissionLog]& missions)
+        @staticmethod
+        const char* violationName(int kind)
+        @staticmethod
+        vector[MissionLog] loadMissions(const string& filename, LoadReport* report)
 
 # ==========================================
 # 2. Global Variables
@@ -261,6 +274,18 @@ cdef double TIME_PROCESS = 10.0
 cdef int AGV_COUNT = 3
 cdef int BEAM_WIDTH = 100
 cdef int PORT_COUNT = 5
+cdef int NUM_THREADS = 0  # beam expansion threads (0 = OpenMP default)
+cdef bint DEDUP_STATES = True  # keep only the best-f node per (yard, AGV) state in each layer
+cdef int FRONT_RULE = 0  # Front Rule stage: 0 = off, 1 = prune, 2 = replace (README §5)
+cdef int FRONT_WINDOW = 3
+cdef int FRONT_SHORTLIST = 4
+cdef SearchStats LAST_STATS  # instrumentation of the last full solve (only with BBS_STATS=1 builds)
+cdef bint ADAPTIVE_WIDTH = False  # per-layer beam width up to BEAM_WIDTH (README §4.5)
+cdef int MIN_BEAM_WIDTH = 1
+cdef double WIDTH_GAP = 5.0
+cdef long long NODE_BUDGET = 0
+cdef vector[LayerWidth] LAST_WIDTHS  # width of every layer of the last full solve
+cdef int DESTINATION_CANDIDATES = 0  # Case B / D destinations per node from the yard's index (0 = every column)
 
 def set_config(double t_travel, double t_handle, double t_process, int agv_cnt, int beam_w):
     global TIME_TRAVEL_UNIT, TIME_HANDLE, TIME_PROCESS, AGV_COUNT, BEAM_WIDTH
@@ -270,413 +295,130 @@ def set_config(double t_travel, double t_handle, double t_process, int agv_cnt,
     AGV_COUNT = agv_cnt
     BEAM_WIDTH = beam_w
 
-# ==========================================
-# 3. Helper Functions
-# ==========================================
-
-cdef int getSeqIndex(int boxId, vector[int]& seq) noexcept nogil:
-    for k in range(seq.size()):
-        if seq[k] == boxId:
-            return k
-    return 999999 
-
-cdef double calculateRILPenalty(YardSystem& yard, int r, int b, vector[int]& seq, int currentSeqIdx, int movingBoxId) noexcept nogil:
-    cdef int currentTop = yard.tops[r][b]
-    if currentTop == 0:
-        return 0.0 
-
-    cdef int topBoxId = yard.grid[r][b][currentTop - 1]
-    cdef int movingBoxRank = getSeqIndex(movingBoxId, seq)
-    cdef int topBoxRank = getSeqIndex(topBoxId, seq)
-    
-    cdef int t, boxId, rank
-    cdef int blockingCount = 0
-    
-    for t in range(currentTop):
-        boxId = yard.grid[r][b][t]
-        rank = getSeqIndex(boxId, seq)
-        if rank < movingBoxRank:
-            blockingCount += 1
-            
-    cdef double penalty = 0.0
-
-    if blockingCount > 0:
-        penalty += W_PENALTY_BLOCKING * blockingCount 
-    else:
-        if topBoxRank > movingBoxRank:
-            penalty += 0.0 
-        else:
-            if topBoxRank > currentSeqIdx: 
-                penalty += W_PENALTY_LOOKAHEAD / <double>(topBoxRank - currentSeqIdx)
-            else:
-                penalty += 0.0
-
-    return penalty
-
-cdef double getTravelTime(Coordinate src, Coordinate dst) nogil:
-    cdef int r1 = 0 if src.row == -1 else src.row
-    cdef int b1 = 0 if src.bay == -1 else src.bay
-    cdef int r2 = 0 if dst.row == -1 else dst.row
-    cdef int b2 = 0 if dst.bay == -1 else dst.bay
-    cdef double dist = abs(r1 - r2) + abs(b1 - b2)
-    return dist * TIME_TRAVEL_UNIT
-
-cdef double calculate_3D_UBALB(YardSystem& yard, vector[int]& remainingTargets, int currentSeqIdx, bint currentRetrievedStatus) noexcept nogil:
-    cdef double total_time = 0.0
-    cdef size_t i
-    cdef int targetId, topTier, l
-    cdef Coordinate targetPos
-    cdef double distToPort, returnDist, avgDist
-    cdef double minPortDist
-    cdef int p
-
-    for i in range(currentSeqIdx, remainingTargets.size()):
-        targetId = remainingTargets[i]
-
-        if i == currentSeqIdx and currentRetrievedStatus:
-             # Already retrieved (at Port), maybe add some dummy time or skip
-             # Since it's done, we don't need to add costs for it
-             continue
-
-        targetPos = yard.getBoxPosition(targetId)
-        if targetPos.row == -1: continue
-
-        topTier = yard.tops[targetPos.row][targetPos.bay] - 1
-        for l in range(topTier, targetPos.tier, -1):
-            total_time += TIME_HANDLE + TIME_TRAVEL_UNIT + TIME_HANDLE
-        
-        # Calculate distance to the Nearest Port (Optimistic Heuristic)
-        minPortDist = 1e9
-        for p in range(1, PORT_COUNT + 1):
-             # Assume Port location: (-1, -1, p)
-             minPortDist = fmin(minPortDist, getTravelTime(targetPos, make_coord(-1, -1, p)))
-
-        total_time += TIME_HANDLE + minPortDist + TIME_HANDLE + TIME_PROCESS
-        
-        returnDist = (yard.MAX_ROWS + yard.MAX_BAYS) / 2.0 * TIME_TRAVEL_UNIT
-        total_time += TIME_HANDLE + returnDist + TIME_HANDLE
-
-    return total_time / <double>AGV_COUNT
-
-cdef int calculateReturnPenalty(YardSystem& yard, int r, int b, vector[int]& seq, int currentSeqIdx) noexcept nogil:
-    cdef int penalty = 0
-    cdef int currentTop = yard.tops[r][b]
-    cdef int t, boxId, urgency
-    cdef size_t k
+def set_threads(int num_threads):
+    global NUM_THREADS
+    NUM_THREADS = num_threads
+
+def set_dedup(bint enabled):
+    global DEDUP_STATES
+    DEDUP_STATES = enabled
+
+def set_front_rule(str mode, int window=3, int shortlist=4):
+    # mode: 'off' / 'prune' (drop dominated children) / 'replace' (re-time them with the better AGV assignment);
+    # window = missions re-timed (<= 4), shortlist = children checked per beam slot (0 = all)
+    global FRONT_RULE, FRONT_WINDOW, FRONT_SHORTLIST
+    modes = {'off': FRONT_RULE_OFF, 'prune': FRONT_RULE_PRUNE, 'replace': FRONT_RULE_REPLACE}
+    if mode not in modes:
+        raise ValueError(f"unknown Front Rule mode '{mode}' (off / prune / replace)")
+    FRONT_RULE = modes[mode]
+    FRONT_WINDOW = window
+    FRONT_SHORTLIST = shortlist
+
+def set_adaptive_width(bint enabled, int min_width=1, double gap=5.0, long long node_budget=0):
+    # enabled: each layer keeps the children within `gap` seconds of its best f, between
+    #   min_width and set_config's beam width; node_budget > 0 (candidates scored per solve) or a
+    #   run_fixed_solver time_budget additionally narrows layers to finish inside the budget
+    global ADAPTIVE_WIDTH, MIN_BEAM_WIDTH, WIDTH_GAP, NODE_BUDGET
+    ADAPTIVE_WIDTH = enabled
+    MIN_BEAM_WIDTH = min_width
+    WIDTH_GAP = gap
+    NODE_BUDGET = node_budget
+
+def set_destination_candidates(int k):
+    # Returns (Case B) and reshuffles (Case D) score only the k best destination columns of the
+    # yard's index (latest future target first, then nearest to the source) instead of every column; 0 = all
+    global DESTINATION_CANDIDATES
+    DESTINATION_CANDIDATES = k
+
+def last_beam_widths():
+    # [(seq_idx, layer, width, candidates)] of the last run_fixed_solver / run_ga_solver final plan
+    return [(w.seqIdx, w.layer, w.width, w.candidates) for w in LAST_WIDTHS]
+
+def last_search_stats():
+    # Beam search counters of the last run_fixed_solver / run_ga_solver final plan,
+    # or None unless the extension was built with BBS_STATS=1
+    if not SearchStats.compiledIn():
+        return None
+    return {
+        'nodes_generated': LAST_STATS.nodesGenerated,
+        'nodes_kept': LAST_STATS.nodesKept,
+        'bytes_copied': LAST_STATS.bytesCopied,
+        'front_checked': LAST_STATS.frontChecked,
+        'front_pruned': LAST_STATS.frontPruned,
+        'front_improved': LAST_STATS.frontImproved,
+        'candidates': {SearchStats.caseName(c).decode(): LAST_STATS.candidates[c] for c in range(CASE_COUNT)},
+        'phase_sec': {SearchStats.phaseName(p).decode(): LAST_STATS.phaseSec[p] for p in range(PHASE_COUNT)},
+        'layers': [(l.seqIdx, l.layer, l.generated, l.kept) for l in LAST_STATS.layers],
+    }
 
-    for t in range(currentTop):
-        boxId = yard.grid[r][b][t]
-        for k in range(currentSeqIdx + 1, seq.size()):
-            if seq[k] == boxId:
-                urgency = (k - currentSeqIdx)
-                penalty += 1000 // (urgency + 1)
-    return penalty
+cdef class PyYard:
+    # Yard of a binary instance, kept in the C++ flat layout: every entry point accepts it in
+    # place of the box list and copies it as is instead of rebuilding it box by box
+    cdef YardSystem yard
+
+    def boxes(self):
+        # Box dicts (id order), same shape as main.py's load_csv_data
+        return [{'id': b.container_id, 'row': b.row, 'bay': b.bay, 'level': b.level}
+                for b in InstanceFile.snapshot(self.yard)]
+
+def load_instance(str path):
+    # Binary instance (.brp, see InstanceFile.h) as (config, yard, commands), same shape as main.py's
+    # load_csv_data except that the boxes stay in C++ as a PyYard (call .boxes() for the dicts)
+    cdef YardInstance instance
+    cdef string error
+    if not InstanceFile.load(path.encode(), instance, error):
+        raise IOError(error.decode())
+    cdef PyYard yard = PyYard()
+    yard.yard = instance.yard
+    config = {
+        'max_row': instance.config.max_row,
+        'max_bay': instance.config.max_bay,
+        'max_level': instance.config.max_level,
+        'total_boxes': instance.config.total_boxes,
+        't_travel': instance.config.time_travel_unit,
+        't_handle': instance.config.time_handle,
+        't_process': instance.config.time_process,
+    }
+    commands = [{'id': c.parent_carrier_id, 'type': c.cmd_type.decode(),
+                 'dest': {'row': c.dest_position.row, 'bay': c.dest_position.bay, 'level': c.dest_position.level}}
+                for c in instance.commands]
+    return config, yard, commands
+
+cdef SolverConfig currentConfig():
+    cdef SolverConfig config
+    config.timeTravelUnit = TIME_TRAVEL_UNIT
+    config.timeHandle = TIME_HANDLE
+    config.timeProcess = TIME_PROCESS
+    config.agvCount = AGV_COUNT
+    config.beamWidth = BEAM_WIDTH
+    config.portCount = PORT_COUNT
+    config.numThreads = NUM_THREADS
+    config.dedupStates = DEDUP_STATES
+    config.frontRule = FRONT_RULE
+    config.frontWindow = FRONT_WINDOW
+    config.frontShortlist = FRONT_SHORTLIST
+    config.adaptiveWidth = ADAPTIVE_WIDTH
+    config.minBeamWidth = MIN_BEAM_WIDTH
+    config.widthGap = WIDTH_GAP
+    config.nodeBudget = NODE_BUDGET
+    config.destinationCandidates = DESTINATION_CANDIDATES
+    config.penaltyBlocking = W_PENALTY_BLOCKING
+    config.penaltyLookahead = W_PENALTY_LOOKAHEAD
+    return config
 
 # ==========================================
-# 4. BBS Solver
+# 3. Progress Callback
 # ==========================================
-cdef vector[MissionLog] solveAndRecord(YardSystem& initialYard, vector[int]& seq) noexcept nogil:
-    srand(12345)
-    
-    cdef SearchNode root
-    root.yard = initialYard
-    root.g = 0
-    root.h = 0
-    root.f = 0
-    root.isCurrentTargetRetrieved = False
-    
-    root.gridBusyTime.resize(initialYard.MAX_ROWS, vector[double](initialYard.MAX_BAYS, 0.0))
-    root.portsBusyTime.resize(PORT_COUNT + 1, 0.0)
-    
-    cdef int i
-    cdef Agent agv
-    agv.currentPos = make_coord(0, 0, 0)
-    agv.availableTime = 0.0
-    
-    for i in range(AGV_COUNT):
-        agv.id = i
-        root.agvs.push_back(agv)
-
-    cdef vector[SearchNode] currentBeam
-    currentBeam.push_back(root)
-    
-    cdef size_t seqIdx
-    cdef int targetId, expansion_limit
-    cdef bint targetCycleDone
-    cdef vector[SearchNode] nextBeam
-    
-    cdef SearchNode node, newNode
-    cdef Coordinate targetPos, src, dst, selectedPortCoord
-    cdef int r, b, bestAGV, blockerId, selectedPort
-    cdef double bestFinishTime, bestStartTime, travel, start, travelToDest, finish, pickupDoneTime, maxAGV, pickupTime, penalty, noise
-    cdef double arrivalAtPort, portReadyTime, agvArrivalAtPort, processStart
-    cdef double minPortFinishTime, dropOffTime, agvFreeTime # [NEW]
-    cdef double portFinishTime
-    cdef bint isTop
-    cdef vector[int] blockers
-    cdef MissionLog log
-    cdef int movingBoxId, p, port_idx
-
-    for seqIdx in range(seq.size()):
-        targetId = seq[seqIdx]
-        targetCycleDone = False
-        expansion_limit = 0
-        
-        while not targetCycleDone and expansion_limit < 40:
-            expansion_limit += 1
-            nextBeam.clear()
-
-            for node in currentBeam:
-                targetPos = node.yard.getBoxPosition(targetId)
-
-                # Case A: DONE
-                if targetPos.row != -1 and node.isCurrentTargetRetrieved:
-                    nextBeam.push_back(node)
-                    targetCycleDone = True
-                    continue
-                
-                # Case B: RETURN (Port -> Yard)
-                if targetPos.row == -1:
-                    selectedPort = targetPos.tier 
-                    src = make_coord(-1, -1, selectedPort)
-                    
-                    for r in range(node.yard.MAX_ROWS):
-                        for b in range(node.yard.MAX_BAYS):
-                            if not node.yard.canReceiveBox(r, b): continue
-                            
-                            dst = make_coord(r, b, node.yard.tops[r][b])
-                            penalty = calculateReturnPenalty(node.yard, r, b, seq, seqIdx)
-                            
-                            bestAGV = -1
-                            bestFinishTime = 1e9
-                            bestStartTime = 0
-                            
-                            for i in range(AGV_COUNT):
-                                travel = getTravelTime(node.agvs[i].currentPos, src)
-                                # Start time: AGV must be free AND Port must be done processing
-                                start = fmax(node.agvs[i].availableTime, node.portsBusyTime[selectedPort])
-                                travelToDest = getTravelTime(src, dst)
-                                finish = start + travel + TIME_HANDLE + travelToDest + TIME_HANDLE
-                                
-                                if finish < bestFinishTime:
-                                    bestFinishTime = finish
-                                    bestAGV = i
-                                    bestStartTime = start
-                            
-                            newNode = node
-                            newNode.yard.returnFromPort(targetId, dst.row, dst.bay)
-                            newNode.isCurrentTargetRetrieved = True 
-                            newNode.agvs[bestAGV].currentPos = dst
-                            newNode.agvs[bestAGV].availableTime = bestFinishTime
-                            newNode.gridBusyTime[dst.row][dst.bay] = bestFinishTime
-                            
-                            maxAGV = 0
-                            for i in range(AGV_COUNT):
-                                maxAGV = fmax(maxAGV, newNode.agvs[i].availableTime)
-                            newNode.g = maxAGV
-                            newNode.h = calculate_3D_UBALB(newNode.yard, seq, seqIdx + 1, False) 
-                            noise = (<double>rand() / <double>RAND_MAX) * 0.01
-                            newNode.f = newNode.g + newNode.h + penalty + noise
-                            
-                            log.mission_no = newNode.history.size() + 1
-                            log.agv_id = bestAGV
-                            log.type_code = 2 
-                            log.batch_id = 20260117
-                            log.container_id = targetId
-                            log.related_target_id = targetId
-                            log.src = src
-                            log.dst = dst
-                            log.start_time_epoch = <long long>bestStartTime + 1705363200
-                            log.end_time_epoch = <long long>bestFinishTime + 1705363200
-                            log.makespan_snapshot = newNode.g
-                            log.mission_priority = 0
-                            log.mission_status = 0
-                            
-                            newNode.history.push_back(log)
-                            nextBeam.push_back(newNode)
-                    continue 
-
-                # Case C: RETRIEVE (Yard -> Port)
-                isTop = node.yard.isTop(targetId)
-                if isTop:
-                    src = node.yard.getBoxPosition(targetId)
-                    bestAGV = -1
-                    bestFinishTime = 1e9
-                    bestAGVFreeTime = 1e9 # [NEW] Track when AGV becomes free
-                    bestStartTime = 0
-                    selectedPort = -1
-                    
-                    for i in range(AGV_COUNT):
-                        travel = getTravelTime(node.agvs[i].currentPos, src)
-                        start = fmax(node.agvs[i].availableTime, node.gridBusyTime[src.row][src.bay])
-                        arrivalAtPort = start + travel + TIME_HANDLE + getTravelTime(src, make_coord(-1, -1, 1))
-                        
-                        p = -1
-                        for port_idx in range(1, PORT_COUNT + 1):
-                            if node.portsBusyTime[port_idx] <= arrivalAtPort:
-                                p = port_idx
-                                break
-                        if p == -1:
-                            minPortFinishTime = 1e9
-                            for port_idx in range(1, PORT_COUNT + 1):
-                                if node.portsBusyTime[port_idx] < minPortFinishTime:
-                                    minPortFinishTime = node.portsBusyTime[port_idx]
-                                    p = port_idx
-                        
-                        selectedPortCoord = make_coord(-1, -1, p)
-                        travelToDest = getTravelTime(src, selectedPortCoord)
-                        portReadyTime = node.portsBusyTime[p]
-                        
-                        agvArrivalAtPort = start + travel + TIME_HANDLE + travelToDest
-                        
-                        # Process starts when AGV arrives (Port ready time handled by constraint above or simple queueing)
-                        # Actually, strictly: Process Start = Max(AGV Arrival, Port Ready)
-                        processStart = fmax(agvArrivalAtPort, portReadyTime)
-                        
-                        # [KEY CHANGE] Decouple AGV and Port
-                        # AGV Free: After drop off (Handle time)
-                        agvFreeTime = processStart + TIME_HANDLE 
-                        
-                        # Port Free: After processing finishes
-                        portFinishTime = processStart + TIME_HANDLE + TIME_PROCESS
-                        
-                        # Metric: We still minimize Port Finish Time (to get job done), 
-                        # OR minimize AGV Free Time (to free up AGV)?
-                        # Let's minimize Port Finish Time to ensure system throughput.
-                        if portFinishTime < bestFinishTime:
-                            bestFinishTime = portFinishTime
-                            bestAGVFreeTime = agvFreeTime # Store this
-                            bestAGV = i
-                            bestStartTime = start
-                            selectedPort = p
-
-                    newNode = node
-                    newNode.yard.moveToPort(targetId, selectedPort)
-                    newNode.isCurrentTargetRetrieved = True 
-                    
-                    selectedPortCoord = make_coord(-1, -1, selectedPort)
-                    newNode.agvs[bestAGV].currentPos = selectedPortCoord
-                    
-                    # [KEY CHANGE] AGV is free earlier!
-                    newNode.agvs[bestAGV].availableTime = bestAGVFreeTime
-                    
-                    # Port is busy longer!
-                    newNode.portsBusyTime[selectedPort] = bestFinishTime
-                    
-                    pickupDoneTime = bestStartTime + getTravelTime(node.agvs[bestAGV].currentPos, src) + TIME_HANDLE
-                    newNode.gridBusyTime[src.row][src.bay] = pickupDoneTime
-
-                    maxAGV = 0
-                    for i in range(AGV_COUNT):
-                        maxAGV = fmax(maxAGV, newNode.agvs[i].availableTime)
-                    newNode.g = maxAGV
-                    newNode.h = calculate_3D_UBALB(newNode.yard, seq, seqIdx, True) 
-                    noise = (<double>rand() / <double>RAND_MAX) * 0.01
-                    newNode.f = newNode.g + newNode.h + noise
-
-                    log.mission_no = newNode.history.size() + 1
-                    log.agv_id = bestAGV
-                    log.type_code = 0 
-                    log.batch_id = 20260117
-                    log.container_id = targetId
-                    log.related_target_id = targetId
-                    log.src = src
-                    log.dst = selectedPortCoord 
-                    log.start_time_epoch = <long long>bestStartTime + 1705363200
-                    # Log END time as AGV release time? Or Process Finish?
-                    # Usually "Mission End" is when AGV is done.
-                    log.end_time_epoch = <long long>bestAGVFreeTime + 1705363200
-                    log.makespan_snapshot = newNode.g
-                    log.mission_priority = 0
-                    log.mission_status = 0
-
-                    newNode.history.push_back(log)
-                    nextBeam.push_back(newNode)
-                else:
-                    # Case D: RESHUFFLE
-                    blockers = node.yard.getBlockingBoxes(targetId)
-                    if blockers.empty(): continue
-                    blockerId = blockers.back()
-                    movingBoxId = blockerId 
-                    src = node.yard.getBoxPosition(blockerId)
-
-                    for r in range(node.yard.MAX_ROWS):
-                        for b in range(node.yard.MAX_BAYS):
-                            if r == src.row and b == src.bay: continue
-                            if not node.yard.canReceiveBox(r, b): continue
-                            
-                            dst = make_coord(r, b, node.yard.tops[r][b])
-                            
-                            penalty = calculateRILPenalty(node.yard, r, b, seq, seqIdx, movingBoxId)
-
-                            bestAGV = -1
-                            bestFinishTime = 1e9
-                            bestStartTime = 0
-
-                            for i in range(AGV_COUNT):
-                                travel = getTravelTime(node.agvs[i].currentPos, src)
-                                colReady = fmax(node.gridBusyTime[src.row][src.bay], node.gridBusyTime[r][b])
-                                start = fmax(node.agvs[i].availableTime, colReady)
-                                travelToDest = getTravelTime(src, dst)
-                                finish = start + travel + TIME_HANDLE + travelToDest + TIME_HANDLE
-                                if finish < bestFinishTime:
-                                    bestFinishTime = finish
-                                    bestAGV = i
-                                    bestStartTime = start
-                            
-                            newNode = node
-                            newNode.yard.moveBox(src.row, src.bay, dst.row, dst.bay)
-                            newNode.agvs[bestAGV].currentPos = dst
-                            newNode.agvs[bestAGV].availableTime = bestFinishTime
-                            pickupTime = bestStartTime + getTravelTime(node.agvs[bestAGV].currentPos, src) + TIME_HANDLE
-                            newNode.gridBusyTime[src.row][src.bay] = pickupTime
-                            newNode.gridBusyTime[dst.row][dst.bay] = bestFinishTime
-                            
-                            maxAGV = 0
-                            for i in range(AGV_COUNT):
-                                maxAGV = fmax(maxAGV, newNode.agvs[i].availableTime)
-                            newNode.g = maxAGV
-                            newNode.h = calculate_3D_UBALB(newNode.yard, seq, seqIdx, False)
-                            noise = (<double>rand() / <double>RAND_MAX) * 0.01
-                            newNode.f = newNode.g + newNode.h + penalty + noise
-
-                            log.mission_no = newNode.history.size() + 1
-                            log.agv_id = bestAGV
-                            log.type_code = 1 
-                            log.batch_id = 20260117
-                            log.container_id = blockerId
-                            log.related_target_id = targetId
-                            log.src = src
-                            log.dst = dst
-                            log.start_time_epoch = <long long>bestStartTime + 1705363200
-                            log.end_time_epoch = <long long>bestFinishTime + 1705363200
-                            log.makespan_snapshot = newNode.g
-                            log.mission_priority = 0
-                            log.mission_status = 0
-
-                            newNode.history.push_back(log)
-                            nextBeam.push_back(newNode)
-
-            if nextBeam.empty(): break
-            sort(nextBeam.begin(), nextBeam.end())
-            if nextBeam.size() > BEAM_WIDTH:
-                nextBeam.resize(BEAM_WIDTH)
-            
-            currentBeam = nextBeam
-            
-            check = currentBeam[0].yard.getBoxPosition(targetId)
-            if check.row != -1 and currentBeam[0].isCurrentTargetRetrieved:
-                targetCycleDone = True
-
-        if currentBeam.empty(): return vector[MissionLog]()
-        
-        for i in range(currentBeam.size()):
-            currentBeam[i].isCurrentTargetRetrieved = False
-
-    return currentBeam[0].history
+cdef int reportProgress(void* ctx, double elapsed, double best, double evalsPerSec) noexcept with gil:
+    # Calls the Python callback; returning False (or raising) stops the search early
+    try:
+        return (<object>ctx)(elapsed, best, evalsPerSec) is not False
+    except Exception as e:
+        print(f"progress callback failed: {e!r}")
+        return False
 
 # ==========================================
-# 5. Entry Point
+# 4. Entry Point
 # ==========================================
 
 cdef class PyMissionLog:
@@ -691,28 +433,18 @@ cdef class PyMissionLog:
     cdef public long long end_time
     cdef public double makespan
 
-def run_fixed_solver(dict config, list boxes, list commands, list fixed_seq_ids):
-    # 1. Setup Data
-    cdef YardSystem initialYard
-    initialYard.init(config['max_row'], config['max_bay'], config['max_level'], config['total_boxes'])
-    
+cdef YardSystem buildYard(dict config, boxes):
+    # boxes: list of box dicts, or a PyYard from load_instance (already built, config is not needed)
+    if isinstance(boxes, PyYard):
+        return (<PyYard>boxes).yard
+    cdef YardSystem yard = YardSystem(config['max_row'], config['max_bay'], config['max_level'], config['total_boxes'])
     for box in boxes:
-        initialYard.initBox(box['id'], box['row'], box['bay'], box['level'])
+        yard.initBox(box['id'], box['row'], box['bay'], box['level'])
+    return yard
 
-    cdef vector[int] sequence
-    
-    # Prepare Sequence Vector
-    for pid in fixed_seq_ids:
-        sequence.push_back(pid)
-    
-    print(f"Running Fixed Sequence Solver with {sequence.size()} targets...")
-    
-    # 2. Run Solver (Once)
-    cdef vector[MissionLog] finalLogs = solveAndRecord(initialYard, sequence)
-    
-    # 3. Convert Results
+cdef list convertLogs(vector[MissionLog]& logs):
     py_logs = []
-    for log in finalLogs:
+    for log in logs:
         pl = PyMissionLog()
         pl.mission_no = log.mission_no
         pl.agv_id = log.agv_id
@@ -729,5 +461,232 @@ def run_fixed_solver(dict config, list boxes, list commands, list fixed_seq_ids)
         pl.end_time = log.end_time_epoch
         pl.makespan = log.makespan_snapshot
         py_logs.append(pl)
-        
-    return py_logs
\ No newline at end of file
+    return py_logs
+
+def run_fixed_solver(dict config, boxes, list commands, list fixed_seq_ids, double time_budget=0.0, progress=None):
+    # time_budget: wall-clock seconds (0 = no limit). When it runs out, the best partial
+    #   plan is finished greedily (beam width 1) so a complete mission log is returned.
+    # progress: optional callable(elapsed_sec, best_makespan, evals_per_sec), called after
+    #   every target; return False to stop early the same way.
+    # 1. Setup Data
+    cdef YardSystem initialYard = buildYard(config, boxes)
+
+    cdef vector[int] sequence
+    
+    # Prepare Sequence Vector
+    for pid in fixed_seq_ids:
+        sequence.push_back(pid)
+    
+    print(f"Running Fixed Sequence Solver with {sequence.size()} targets...")
+    
+    # 2. Run Solver (Once)
+    cdef SolveProgressFn progressFn = NULL
+    if progress is not None:
+        progressFn = reportProgress
+    cdef void* progressCtx = <void*>progress
+    cdef MakespanSolver* solver = new MakespanSolver(currentConfig())
+    cdef vector[MissionLog] finalLogs
+    LAST_STATS.reset()
+    LAST_WIDTHS.clear()
+    try:
+        with nogil:
+            finalLogs = solver.solve(initialYard, sequence, time_budget, progressFn, progressCtx, &LAST_STATS, &LAST_WIDTHS)
+    finally:
+        del solver
+    
+    # 3. Convert Results
+    return convertLogs(finalLogs)
+
+def run_ga_solver(dict config, boxes, list commands, list target_ids=None, int eval_beam_width=10,
+                  int population_size=50, int generations=30, int islands=1, int workers=0,
+                  unsigned int seed=0, double time_budget=0.0, bint verbose=False):
+    # Optimizes the retrieval order for makespan, then re-plans the winner at full width.
+    # target_ids: targets to order (default: every "target" command whose box is in the yard)
+    # eval_beam_width: beam width of each GA fitness evaluation (the final plan uses set_config's width)
+    # workers: GA fitness threads (0 = all cores); seed 0 = seed from the clock
+    # time_budget > 0: evolve until that many seconds have passed instead of `generations`
+    # Returns (optimized sequence, mission logs of the final plan)
+    cdef YardSystem initialYard = buildYard(config, boxes)
+
+    cdef vector[int] targets
+    if target_ids is None:
+        target_ids = [cmd['id'] for cmd in commands if cmd['type'] == 'target' and cmd['id'] >= 0
+                      and initialYard.getBoxPosition(cmd['id']).row != -1]
+    for pid in target_ids:
+        targets.push_back(pid)
+    if targets.empty():
+        return [], []
+    if seed == 0:
+        seed = <unsigned int>(time.time_ns() & 0xFFFFFFFF)
+
+    cdef SolverConfig evalConfig = currentConfig()
+    evalConfig.beamWidth = eval_beam_width
+
+    cdef GAConfig gaConfig
+    gaConfig.populationSize = population_size
+    gaConfig.maxGenerations = generations
+    gaConfig.islandCount = islands
+    gaConfig.workers = workers
+    gaConfig.verbose = verbose
+
+    print(f"Running Makespan GA with {targets.size()} targets (eval beam {eval_beam_width}, final beam {BEAM_WIDTH}, seed {seed})...")
+
+    # 1. GA over sequences; fitness = makespan under the narrow evaluation beam,
+    #    individuals are evaluated in parallel (each evaluation single-threaded)
+    cdef MakespanObjective* objective = new MakespanObjective(initialYard, evalConfig)
+    cdef GeneticAlgorithm[MakespanObjective]* ga = NULL
+    cdef vector[int] bestSeq
+    cdef double gaMakespan = 0
+    try:
+        ga = new GeneticAlgorithm[MakespanObjective](objective[0], targets, seed, gaConfig)
+        ga.setTimeBudget(time_budget)
+        with nogil:
+            ga.solve()
+        bestSeq = ga.getBestSequence()
+        gaMakespan = ga.getBestFitness()
+        if verbose:
+            print(f"GA workers: {ga.getWorkerCount()}, fitness cache: {ga.getCacheHits()} hits / {ga.getCacheMisses()} misses")
+    finally:
+        del ga
+        del objective
+
+    # 2. Re-solve the winner with the full beam width for the final mission log
+    cdef MakespanSolver* solver = new MakespanSolver(currentConfig())
+    cdef vector[MissionLog] finalLogs
+    LAST_STATS.reset()
+    LAST_WIDTHS.clear()
+    try:
+        with nogil:
+            finalLogs = solver.solve(initialYard, bestSeq, 0.0, NULL, NULL, &LAST_STATS, &LAST_WIDTHS)
+    finally:
+        del solver
+
+    cdef double finalMakespan = finalLogs.back().makespan_snapshot if not finalLogs.empty() else 0.0
+    print(f"GA makespan (beam {eval_beam_width}): {gaMakespan:.1f}s, final plan (beam {BEAM_WIDTH}): {finalMakespan:.1f}s")
+    return list(bestSeq), convertLogs(finalLogs)
+
+cdef class OnlinePlanner:
+    # Rolling-horizon replanning (README §4.4): feed commands / AGV / port updates as they happen,
+    # call replan(now) to get the missions committed for execution. Times are epoch seconds.
+    # Uses the solver settings (set_config / set_front_rule / ...) current at construction.
+    cdef RollingPlanner* planner
+
+    def __cinit__(self, dict config, boxes, int window=12, int commit=8, int population_size=20,
+                  int generations=10, double time_budget=0.0, int eval_beam_width=5, int workers=0, unsigned int seed=1):
+        cdef YardSystem initialYard = buildYard(config, boxes)
+        cdef RollingConfig rollingConfig
+        rollingConfig.windowTargets = window
+        rollingConfig.commitMissions = commit
+        rollingConfig.populationSize = population_size
+        rollingConfig.generations = generations
+        rollingConfig.timeBudget = time_budget
+        rollingConfig.evalBeamWidth = eval_beam_width
+        rollingConfig.workers = workers
+        rollingConfig.seed = seed
+        self.planner = new RollingPlanner(initialYard, currentConfig(), rollingConfig)
+
+    def __dealloc__(self):
+        del self.planner
+
+    def add_command(self, int box_id, long long create_time, int priority=0, int cmd_no=0):
+        # New retrieval target; False when the box is not in the yard or already pending
+        cdef Command cmd
+        cmd.cmd_no = cmd_no
+        cmd.cmd_type = b"target"
+        cmd.cmd_priority = priority
+        cmd.parent_carrier_id = box_id
+        cmd.create_time = create_time
+        return self.planner.addCommand(cmd)
+
+    def update_agv(self, int agv, int row, int bay, long long available_time):
+        self.planner.updateAgv(agv, Coordinate(row, bay, 0), available_time)
+
+    def update_port(self, int port, long long busy_until):
+        self.planner.updatePort(port, busy_until)
+
+    def replan(self, long long now):
+        cdef vector[MissionLog] committed
+        with nogil:
+            committed = self.planner.replan(now)
+        return convertLogs(committed)
+
+    def last_report(self):
+        cdef ReplanReport report = self.planner.lastReport()
+        return {
+            'window_targets': report.windowTargets,
+            'committed_missions': report.committedMissions,
+            'committed_targets': report.committedTargets,
+            'pending_targets': report.pendingTargets,
+            'planned_makespan': report.plannedMakespan,
+            'latency_sec': report.latencySec,
+            'dead_end': report.deadEnd,
+        }
+
+    @property
+    def pending(self):
+        return self.planner.pendingCount()
+
+def simulate_missions(dict config, boxes, missions, bint asap=False, double tolerance=1.0, int max_violations=20):
+    # Discrete-event replay of a plan (README §6.3): `missions` is a list of mission logs (run_fixed_solver,
+    # run_ga_solver, OnlinePlanner.replan) or the path of a makespan output_missions.csv.
+    # asap=False replays at the logged start times, asap=True re-times the plan in its own order.
+    # AGV / port counts and times come from set_config.
+    cdef YardSystem initialYard = buildYard(config, boxes)
+    cdef vector[MissionLog] logs
+    cdef LoadReport loadReport
+    cdef MissionLog log
+    if isinstance(missions, str):
+        logs = MissionSimulator.loadMissions(missions.encode(), &loadReport)
+        if not loadReport.opened:
+            raise IOError(f"cannot open {missions}")
+        if not loadReport.errors.empty():
+            raise ValueError(f"{missions}:{loadReport.errors[0].line}: {loadReport.errors[0].message.decode()}")
+    else:
+        types = {'target': 0, 'reshuffle': 1, 'return': 2}
+        for m in missions:
+            log.mission_no = m.mission_no
+            log.agv_id = m.agv_id
+            log.batch_id = 0
+            log.container_id = m.container_id
+            log.related_target_id = m.related_target_id
+            log.src = Coordinate(m.src[0], m.src[1], m.src[2])
+            log.dst = Coordinate(m.dst[0], m.dst[1], m.dst[2])
+            log.start_time_epoch = m.start_time
+            log.end_time_epoch = m.end_time
+            log.makespan_snapshot = m.makespan
+            log.type_code = types.get(m.mission_type, -1)
+            log.mission_priority = 0
+            log.mission_status = 0
+            logs.push_back(log)
+
+    cdef SimulationConfig simConfig
+    simConfig.followLoggedTimes = not asap
+    simConfig.timeTolerance = tolerance
+    simConfig.maxViolations = max_violations
+    cdef MissionSimulator* simulator = new MissionSimulator(initialYard, currentConfig(), simConfig)
+    cdef SimulationReport report
+    try:
+        with nogil:
+            report = simulator.run(logs)
+    finally:
+        del simulator
+
+    return {
+        'valid': report.valid,
+        'missions': report.missions,
+        'events': report.events,
+        'makespan': report.makespan,
+        'port_makespan': report.portMakespan,
+        'logged_makespan': report.loggedMakespan,
+        'max_time_deviation': report.maxTimeDeviation,
+        'violation_counts': {MissionSimulator.violationName(k).decode(): report.violationCount[k]
+                             for k in range(SIM_VIOLATION_KINDS)},
+        'violations': [(v.missionNo, MissionSimulator.violationName(v.kind).decode(), v.time, v.detail.decode())
+                       for v in report.violations],
+        'agvs': [{'missions': a.missions, 'busy': a.busyTime, 'wait': a.waitTime, 'utilization': a.utilization}
+                 for a in report.agvs],
+        'ports': {p: {'retrievals': report.ports[p].retrievals, 'queued': report.ports[p].queued,
+                      'queue_time': report.ports[p].queueTime, 'max_queue_time': report.ports[p].maxQueueTime,
+                      'busy': report.ports[p].busyTime, 'peak_boxes': report.ports[p].peakBoxes}
+                  for p in range(1, report.ports.size())},
+    }
@@ -7,36 +7,67 @@
 #include <iomanip>
 #include <fstream>
 #include <sstream>
-#include <unordered_map>
+
+#include <cstdlib>
+#include <cstring>
 
 // Load Modules
 #include "DataLoader.h"
+#include "InstanceFile.h"
 #include "YardSystem.h"
+#include "BeamSelect.h"
+#include "PrefixCheckpoint.h"
+#include "MakespanSolver.h"
+#include "GeneticAlgorithm.h"
+#include "RollingPlanner.h"
+#include "SearchStats.h"
 
 // --- Parameter Settings ---
 const int POPULATION_SIZE = 50;
 const int MAX_GENERATIONS = 30;
 const double MUTATION_RATE = 0.2;
+const double CROSSOVER_RATE = 0.7; // chance that a child is built with Order Crossover (OX)
+const int ISLAND_COUNT = 1;        // GA sub-populations (POPULATION_SIZE is split between them), overridable from argv
+const int MIGRATION_INTERVAL = 5;  // generations between migrations
+const int MIGRANT_COUNT = 2;       // best individuals sent to the next island (ring)
+const double TIME_BUDGET_SEC = 0;  // GA wall-clock budget (0 = run MAX_GENERATIONS), overridable from argv
 const int BEAM_WIDTH = 1; // change to smaller value if runtime is too long
-
-// --- Output Format Definition ---
-struct MissionLog {
-    int mission_no;
-    std::string mission_type;     // "target", "block", or "return"
-    int batch_id;
-    int container_id;
-    Coordinate src;
-    Coordinate dst;               // If type is target, dst is (-1,-1,-1) / Workstation
-    int mission_priority;
-    std::string mission_status;   // "PLANNED"
-    long long created_time;
-};
+const bool DEDUP_STATES = true; // keep only the best node per yard state (Zobrist hash) in each layer
+const int DESTINATION_CANDIDATES = 0; // reshuffle destinations tried per node, best of the yard's index (0 = every column, README §4.6)
+const int EVAL_WORKERS = 0;       // GA fitness threads (0 = all hardware threads), overridable from argv
+const unsigned int RANDOM_SEED = 0; // 0 = seed from the clock, overridable from argv
+const size_t FITNESS_CACHE_SIZE = 1 << 14; // max cached sequences (0 = no cache)
+const size_t CHECKPOINT_BUDGET_MB = 32; // memory for GA prefix checkpoints (0 = always evaluate from scratch)
+const int CHECKPOINT_STRIDE = 2;        // save the beam after every N-th target
+const bool OPTIMIZE_MAKESPAN = false;   // GA objective: false = reshuffle count, true = multi-AGV makespan (argv)
+const int MAKESPAN_BEAM_WIDTH = 10;     // beam width of the makespan solver (GA fitness and final plan)
+const int FRONT_RULE_MODE = FRONT_RULE_OFF; // makespan solver's Front Rule stage (README §5): OFF / PRUNE / REPLACE
+const bool ADAPTIVE_BEAM_WIDTH = false;  // makespan solver: per-layer width up to MAKESPAN_BEAM_WIDTH (README §4.5)
+const int MIN_BEAM_WIDTH = 1;           // adaptive: narrowest layer
+const double BEAM_WIDTH_GAP = 5.0;      // adaptive: children within this many seconds of the layer's best f are kept
+const long long BEAM_NODE_BUDGET = 0;   // adaptive: candidates scored per solve (0 = no limit)
+const int MAKESPAN_DESTINATIONS = 0;    // makespan solver: return / reshuffle destinations per node (0 = every column, README §4.6)
+const int ONLINE_WINDOW_TARGETS = 12;   // --online: released targets planned per replan (README §4.4)
+const int ONLINE_COMMIT_MISSIONS = 8;   // --online: missions committed per replan (completed to a target boundary)
 
 // ==========================================
 // Core Module 1: BBS Evaluator (Revised: With Lookahead Penalty)
 // ==========================================
 class BBS_Evaluator {
 public:
+    // --- Output Format Definition ---
+    struct MissionLog {
+        int mission_no;
+        std::string mission_type;     // "target", "block", or "return"
+        int batch_id;
+        int container_id;
+        Coordinate src;
+        Coordinate dst;               // If type is target, dst is (-1,-1,-1) / Workstation
+        int mission_priority;
+        std::string mission_status;   // "PLANNED"
+        long long created_time;
+    };
+
     // Lightweight Node for GA
     struct SearchNode {
         YardSystem yard;
@@ -45,50 +76,91 @@ public:
         bool operator<(const SearchNode& other) const { return f < other.f; } // Sort by f
     };
 
+    // Shared Mission History (Arena-backed persistent list)
+    // Each node keeps only the index of its latest mission; siblings share the common prefix,
+    // so an expansion appends one entry instead of copying the whole log so far.
+    struct HistoryArena {
+        struct Entry {
+            MissionLog log;
+            int prev; // Previous mission of the same branch (-1 = none)
+        };
+        std::vector<Entry> entries;
+
+        int append(int prev, const MissionLog& m) {
+            entries.push_back({m, prev});
+            return (int)entries.size() - 1;
+        }
+
+        // Walk the parent chain back to the root (only done for the winning node)
+        std::vector<MissionLog> reconstruct(int tail) const {
+            std::vector<MissionLog> logs;
+            for (int e = tail; e != -1; e = entries[e].prev) logs.push_back(entries[e].log);
+            std::reverse(logs.begin(), logs.end());
+            return logs;
+        }
+    };
+
     // Node with History Logging for Output
     struct LogNode {
         YardSystem yard;
         int g; // Actual Cost
         int f; // Sorting Score (g + penalty)
-        std::vector<MissionLog> history;
+        int historyTail; // Latest mission in the HistoryArena (-1 = none)
         bool operator<(const LogNode& other) const { return f < other.f; } // Sort by f
     };
 
+    static size_t nodeBytes(const LogNode& n) { return sizeof(LogNode) + n.yard.storage.size() * sizeof(int); }
+
+    // Candidate Move (Stage 1 of expansion): scored against the parent yard,
+    // only materialized into a full node if it survives the beam pruning
+    struct MoveCandidate {
+        int parent;          // Index into the processing beam
+        int srcRow, srcBay;  // Column of the blocker being moved
+        int dstRow, dstBay;  // Destination column
+        int g; // Actual Cost
+        int f; // Sorting Score (g + penalty)
+        unsigned long long hash; // Yard state hash after the move
+    };
+
+    static int candidateScore(const MoveCandidate& c) { return c.f; }
+    static unsigned long long candidateHash(const MoveCandidate& c) { return c.hash; }
+
+    // Layer pruning: best BEAM_WIDTH candidates, optionally one per distinct yard state
+    static std::vector<int> selectSurvivors(const std::vector<MoveCandidate>& candidates) {
+        if (DEDUP_STATES) return selectTopKUnique(candidates, BEAM_WIDTH, candidateScore, candidateHash);
+        return selectTopK(candidates, BEAM_WIDTH, candidateScore);
+    }
+    template <typename Node> static int nodeScore(const Node& n) { return n.f; }
+
+    // Beam state after the first k targets, used to resume GA evaluations
+    typedef PrefixCheckpointStore<std::vector<SearchNode>> CheckpointStore;
+    typedef CheckpointStore::Checkpoint Checkpoint;
+
     // -------------------------------------------------------------------------
-    // Helper: Calculate Move Penalty (Lookahead: Check if blocking future targets)
-    // Strategy: Scan the entire stack to find the "most urgent" (Minimum Priority) box.
+    // Helper: Dense Rank Table (Box ID -> Sequence Index)
+    // One buffer per thread, refilled for every evaluation instead of building a hash map.
+    // Yards attached to it (YardSystem::attachRanks) must not outlive the current evaluation.
     // -------------------------------------------------------------------------
-    static int calculateMovePenalty(const YardSystem& yard, int r, int b, 
-                                    const std::unordered_map<int, int>& priorityMap, 
-                                    int currentSeqIndex) {
-        
-        int topTier = yard.tops[r][b] - 1;
-        if (topTier < 0) return 0; // Empty stack
-
-        // Initialize to maximum value
-        int minBelowPriority = std::numeric_limits<int>::max();
-        bool foundFutureTarget = false;
+    static const std::vector<int>& buildRankTable(const YardSystem& yard, const std::vector<int>& retrievalSequence) {
+        static thread_local std::vector<int> ranks;
+        int size = yard.BOX_CAPACITY;
+        for (int id : retrievalSequence) size = std::max(size, id + 1);
+        ranks.assign(size, NO_RANK);
+        for (size_t i = 0; i < retrievalSequence.size(); ++i) ranks[retrievalSequence[i]] = (int)i;
+        return ranks;
+    }
 
-        // [CRITICAL] Scan the entire stack (from bottom tier 0 to topTier)
-        for (int t = 0; t <= topTier; ++t) {
-            int boxId = yard.grid[r][b][t];
-            
-            auto it = priorityMap.find(boxId);
-            if (it != priorityMap.end()) {
-                int p = it->second;
-                
-                // Only consider "future" boxes that haven't been retrieved yet (Priority >= current)
-                if (p >= currentSeqIndex) {
-                    if (p < minBelowPriority) {
-                        minBelowPriority = p;
-                        foundFutureTarget = true;
-                    }
-                }
-            }
-        }
+    // -------------------------------------------------------------------------
+    // Helper: Calculate Move Penalty (Lookahead: Check if blocking future targets)
+    // Strategy: Find the "most urgent" (Minimum Priority) future box in the stack.
+    // The yard keeps this per column (Stack-Min), so the lookup is O(1).
+    // -------------------------------------------------------------------------
+    static int calculateMovePenalty(const YardSystem& yard, int r, int b, int currentSeqIndex) {
+        // Only "future" boxes that haven't been retrieved yet (Priority >= current) are tracked
+        int minBelowPriority = yard.columnMinRank(r, b);
 
         // If *any tier* in this stack contains a future target
-        if (foundFutureTarget) {
+        if (minBelowPriority != NO_RANK) {
             // Calculate distance: How soon is the most urgent box needed?
             int distance = minBelowPriority - currentSeqIndex;
 
@@ -97,15 +169,14 @@ public:
             return 1000 + (100000 / (distance + 1)); 
         }
 
-        return 0; // This stack contains only "past" boxes or non-targets; it is safe.
+        return 0; // This stack contains only "past" boxes or non-targets (or is empty); it is safe.
     }
 
     // -------------------------------------------------------------------------
     // Helper: Find Best Return Slot (Return Strategy with Lookahead)
     // -------------------------------------------------------------------------
-    static Coordinate findBestReturnSlot(const YardSystem& yard, int targetId, 
-                                         const std::unordered_map<int, int>& priorityMap, 
-                                         int currentSeqIndex) {
+    static Coordinate findBestReturnSlot(const YardSystem& yard, int targetId, int currentSeqIndex) {
+        if (yard.hasDestinationIndex()) return findBestReturnSlotIndexed(yard, targetId, currentSeqIndex);
         Coordinate bestPos = {-1, -1, -1};
         int minPenalty = std::numeric_limits<int>::max();
 
@@ -116,51 +187,121 @@ public:
                 int penalty = 0;
                 
                 // 1. Calculate penalty for "blocking future targets" (Call logic above)
-                penalty += calculateMovePenalty(yard, r, b, priorityMap, currentSeqIndex);
+                penalty += calculateMovePenalty(yard, r, b, currentSeqIndex);
 
                 // 2. Extra Heuristic: 
                 // If penalty is still 0 (safe), compare ID or height
-                int topTier = yard.tops[r][b] - 1;
+                int topTier = yard.getHeight(r, b) - 1;
                 if (topTier >= 0) {
-                    int boxBelowId = yard.grid[r][b][topTier];
+                    int boxBelowId = yard.getBoxAt(r, b, topTier);
                     // Stability check: Avoid placing on top of more urgent boxes (smaller ID)
                     if (boxBelowId < targetId) penalty += 50; 
-                    else penalty += yard.tops[r][b]; // Stack height penalty (prefer lower stacks)
+                    else penalty += yard.getHeight(r, b); // Stack height penalty (prefer lower stacks)
                 } else {
                     penalty += 20; // Slight penalty for empty columns, prefer stacking on safe boxes
                 }
 
                 if (penalty < minPenalty) {
                     minPenalty = penalty;
-                    bestPos = {r, b, yard.tops[r][b]};
+                    bestPos = {r, b, yard.getHeight(r, b)};
                 }
             }
         }
         return bestPos;
     }
 
+    // Same slot as the scan above, read from the yard's destination index: columns come grouped
+    // by minRank (move penalty ascending), lowest first within a group. A group whose move penalty
+    // already reaches the best total ends the search; within a group, a column of height h adds
+    // at least min(h, 50), so the rest of the group is skipped once that exceeds the best total.
+    static Coordinate findBestReturnSlotIndexed(const YardSystem& yard, int targetId, int currentSeqIndex) {
+        const int* order = yard.destinationOrder();
+        int columns = yard.MAX_ROWS * yard.MAX_BAYS;
+        int bestColumn = -1;
+        int minPenalty = std::numeric_limits<int>::max();
+
+        for (int p = 0; p < columns;) {
+            int r = order[p] / yard.MAX_BAYS, b = order[p] % yard.MAX_BAYS;
+            if (!yard.canReceiveBox(r, b)) break; // full columns are last
+            int movePenalty = calculateMovePenalty(yard, r, b, currentSeqIndex);
+            if (movePenalty >= minPenalty) break;
+
+            int groupEnd = yard.destinationClassEnd(p);
+            for (; p < groupEnd; ++p) {
+                int column = order[p];
+                int height = yard.storage[column];
+                if (height > 0 && movePenalty + std::min(height, 50) > minPenalty) break;
+
+                int penalty = movePenalty;
+                if (height > 0) penalty += (yard.getBoxAt(column / yard.MAX_BAYS, column % yard.MAX_BAYS, height - 1) < targetId) ? 50 : height;
+                else penalty += 20;
+                // Ties go to the first column in row-major order, as in the scan
+                if (penalty < minPenalty || (penalty == minPenalty && column < bestColumn)) {
+                    minPenalty = penalty;
+                    bestColumn = column;
+                }
+            }
+            p = groupEnd;
+        }
+        if (bestColumn == -1) return {-1, -1, -1};
+        return {bestColumn / yard.MAX_BAYS, bestColumn % yard.MAX_BAYS, yard.storage[bestColumn]};
+    }
+
+    // -------------------------------------------------------------------------
+    // Helper: Reshuffle Destinations
+    // Every column that can take the blocker, or with DESTINATION_CANDIDATES > 0 the best ones of
+    // the yard's destination index (README §4.6). The move penalty only depends on the column's
+    // minRank, so these are the best-scored candidates; among equals the nearest to the source.
+    // One buffer per thread, valid until the next call.
+    // -------------------------------------------------------------------------
+    static const std::vector<int>& reshuffleDestinations(const YardSystem& yard, Coordinate src) {
+        static thread_local std::vector<int> columns;
+        int srcColumn = yard.columnIndex(src.row, src.bay);
+        if (yard.hasDestinationIndex()) {
+            yard.bestDestinations(DESTINATION_CANDIDATES, src.row, src.bay, srcColumn, columns);
+            std::sort(columns.begin(), columns.end()); // Row-major like the scan: same tie-breaks
+            return columns;
+        }
+        columns.clear();
+        for (int c = 0; c < yard.MAX_ROWS * yard.MAX_BAYS; ++c) {
+            if (c != srcColumn && yard.storage[c] < yard.MAX_TIERS) columns.push_back(c);
+        }
+        return columns;
+    }
+
     // -------------------------------------------------------------------------
     // 1. Pure Evaluation (For GA)
     // -------------------------------------------------------------------------
     static int evaluate(const YardSystem& initialYard, const std::vector<int>& retrievalSequence) {
-        return run_internal_logic(initialYard, retrievalSequence);
+        return run_internal_logic(initialYard, retrievalSequence, nullptr, nullptr, nullptr);
+    }
+
+    // Resumable evaluation: starts from the longest prefix found in `store` (only read here)
+    // and appends the checkpoints it passes to `saved`, for the caller to insert later.
+    // Move penalties look at the ranks of *later* targets, so a resumed result (resumed = true)
+    // can differ slightly from evaluate(); the GA treats it as approximate.
+    static int evaluateResumable(const YardSystem& initialYard, const std::vector<int>& retrievalSequence,
+                                 CheckpointStore& store, std::vector<Checkpoint>& saved, bool& resumed) {
+        return run_internal_logic(initialYard, retrievalSequence, &store, &saved, &resumed);
     }
 
     // -------------------------------------------------------------------------
     // 2. Execute and Record (For CSV Output)
+    // stats: filled when built with -DBBS_STATS (SearchStats.h), otherwise left untouched
     // -------------------------------------------------------------------------
-    static std::vector<MissionLog> solveAndRecord(const YardSystem& initialYard, const std::vector<int>& retrievalSequence) {
+    static std::vector<MissionLog> solveAndRecord(const YardSystem& initialYard, const std::vector<int>& retrievalSequence,
+                                                  SearchStats* stats = nullptr) {
+        BBS_UNUSED(stats);
+        HistoryArena history;
         std::vector<LogNode> currentBeam;
-        currentBeam.push_back({initialYard, 0, 0, {}}); // g=0, f=0
+        currentBeam.push_back({initialYard, 0, 0, -1}); // g=0, f=0
 
         int missionSerial = 1;
         long long baseTime = 1705363200; 
 
-        // Create Priority Map (ID -> Sequence Index)
-        std::unordered_map<int, int> priorityMap;
-        for(size_t i=0; i<retrievalSequence.size(); ++i) {
-            priorityMap[retrievalSequence[i]] = (int)i;
-        }
+        // Attach the Rank Table (ID -> Sequence Index) to the root yard
+        if (DESTINATION_CANDIDATES > 0) currentBeam[0].yard.enableDestinationIndex();
+        currentBeam[0].yard.attachRanks(buildRankTable(initialYard, retrievalSequence));
 
         // Iterate through each target box
         for (int i = 0; i < retrievalSequence.size(); ++i) {
@@ -175,11 +316,14 @@ public:
 
             int depthSafety = 0;
             while (!processingBeam.empty()) {
-                std::vector<LogNode> nextStepBeam;
+                std::vector<MoveCandidate> candidates;
+
+                for (int k = 0; k < (int)processingBeam.size(); ++k) {
+                    const LogNode& node = processingBeam[k];
 
-                for (const auto& node : processingBeam) {
                     // Case A: Target is at the top -> Retrieve
                     if (node.yard.isTop(targetId)) {
+                        BBS_PHASE_TIMER(stats, PHASE_RETRIEVE);
                         LogNode doneNode = node;
                         Coordinate srcPos = doneNode.yard.getBoxPosition(targetId);
                         doneNode.yard.removeBox(targetId);
@@ -195,83 +339,103 @@ public:
                         m.mission_status = "PLANNED";
                         m.created_time = baseTime;
                         
-                        doneNode.history.push_back(m);
+                        doneNode.historyTail = history.append(doneNode.historyTail, m);
                         
                         // Reset f value, as Phase 1 ends and we don't need previous penalties for Phase 2
                         doneNode.f = doneNode.g; 
                         
                         finishedBeam.push_back(doneNode);
+                        BBS_STAT(if (stats) { stats->candidates[CASE_RETRIEVE]++; stats->bytesCopied += (long long)nodeBytes(doneNode); });
                     } 
-                    // Case B: Target is blocked -> Move blockers
+                    // Case B: Target is blocked -> Score every blocker destination (no copies yet)
                     else {
+                        BBS_PHASE_TIMER(stats, PHASE_RESHUFFLE);
                         std::vector<int> blockers = node.yard.getBlockingBoxes(targetId);
                         if (blockers.empty()) continue; 
 
                         int blockerId = blockers.back();
                         Coordinate srcPos = node.yard.getBoxPosition(blockerId);
 
-                        for (int r = 0; r < node.yard.MAX_ROWS; ++r) {
-                            for (int b = 0; b < node.yard.MAX_BAYS; ++b) {
-                                if (r == srcPos.row && b == srcPos.bay) continue;
-
-                                YardSystem newYard = node.yard;
-                                if (newYard.moveBox(srcPos.row, srcPos.bay, r, b)) {
-                                    LogNode newNode = node;
-                                    newNode.yard = newYard;
-                                    newNode.g += 1; // Increase actual cost
-
-                                    // [CRITICAL] Calculate Penalty: Does this move block a future target?
-                                    int penalty = calculateMovePenalty(node.yard, r, b, priorityMap, i);
-                                    
-                                    // Sorting Score = Actual Cost + Penalty
-                                    newNode.f = newNode.g + penalty;
-
-                                    MissionLog m;
-                                    m.mission_no = missionSerial++;
-                                    m.mission_type = "block";
-                                    m.batch_id = 20260117;
-                                    m.container_id = blockerId;
-                                    m.src = srcPos;
-                                    m.dst = {r, b, newNode.yard.getBoxPosition(blockerId).tier};
-                                    m.mission_priority = 0;
-                                    m.mission_status = "PLANNED";
-                                    m.created_time = baseTime;
-
-                                    newNode.history.push_back(m);
-                                    nextStepBeam.push_back(newNode);
-                                }
-                            }
+                        for (int column : reshuffleDestinations(node.yard, srcPos)) {
+                            int r = column / node.yard.MAX_BAYS;
+                            int b = column % node.yard.MAX_BAYS;
+
+                            // [CRITICAL] Calculate Penalty: Does this move block a future target?
+                            int penalty = calculateMovePenalty(node.yard, r, b, i);
+
+                            // Sorting Score = Actual Cost + Penalty
+                            candidates.push_back({k, srcPos.row, srcPos.bay, r, b, node.g + 1, node.g + 1 + penalty,
+                                                  node.yard.hashAfterMove(srcPos.row, srcPos.bay, r, b)});
                         }
                     }
                 }
                 
-                // Pruning (Phase 1)
-                if (!nextStepBeam.empty()) {
-                    std::sort(nextStepBeam.begin(), nextStepBeam.end());
-                    if (nextStepBeam.size() > BEAM_WIDTH) nextStepBeam.resize(BEAM_WIDTH);
+                // Pruning (Phase 1): partial top-K over the candidate scores
+                std::vector<int> survivors;
+                {
+                    BBS_PHASE_TIMER(stats, PHASE_SELECT);
+                    survivors = selectSurvivors(candidates);
+                }
+                BBS_STAT(if (stats) {
+                    long long retrieved = 0;
+                    for (const auto& node : processingBeam) retrieved += node.yard.isTop(targetId) ? 1 : 0;
+                    stats->candidates[CASE_RESHUFFLE] += (long long)candidates.size();
+                    stats->addLayer(i, depthSafety + 1, (long long)candidates.size() + retrieved, (long long)survivors.size() + retrieved);
+                });
+
+                // Materialize the surviving candidates only
+                BBS_PHASE_TIMER(stats, PHASE_COPY);
+                std::vector<LogNode> nextStepBeam;
+                nextStepBeam.reserve(survivors.size());
+                for (int idx : survivors) {
+                    const MoveCandidate& c = candidates[idx];
+                    LogNode newNode = processingBeam[c.parent];
+                    int blockerId = newNode.yard.getBoxAt(c.srcRow, c.srcBay, newNode.yard.getHeight(c.srcRow, c.srcBay) - 1);
+                    newNode.yard.moveBox(c.srcRow, c.srcBay, c.dstRow, c.dstBay);
+                    newNode.g = c.g; // Increase actual cost
+                    newNode.f = c.f;
+
+                    MissionLog m;
+                    m.mission_no = missionSerial++;
+                    m.mission_type = "block";
+                    m.batch_id = 20260117;
+                    m.container_id = blockerId;
+                    m.src = {c.srcRow, c.srcBay, newNode.yard.getHeight(c.srcRow, c.srcBay)};
+                    m.dst = {c.dstRow, c.dstBay, newNode.yard.getBoxPosition(blockerId).tier};
+                    m.mission_priority = 0;
+                    m.mission_status = "PLANNED";
+                    m.created_time = baseTime;
+
+                    newNode.historyTail = history.append(newNode.historyTail, m);
+                    BBS_STAT(if (stats) stats->bytesCopied += (long long)nodeBytes(newNode));
+                    nextStepBeam.push_back(std::move(newNode));
                 }
-                processingBeam = nextStepBeam;
+                processingBeam = std::move(nextStepBeam);
                 if (++depthSafety > 30) break; 
             }
 
             if (finishedBeam.empty()) return {}; // Dead End
 
             // Use g (actual cost) or f to select best results for Phase 2
-            std::sort(finishedBeam.begin(), finishedBeam.end());
-            if (finishedBeam.size() > BEAM_WIDTH) finishedBeam.resize(BEAM_WIDTH);
+            {
+                BBS_PHASE_TIMER(stats, PHASE_SELECT);
+                keepTopK(finishedBeam, BEAM_WIDTH, nodeScore<LogNode>);
+            }
 
             // ==========================================
             // Phase 2: Inbound (Return Target to Yard)
             // ==========================================
             
             std::vector<LogNode> returnPhaseBeam;
+            BBS_PHASE_TIMER(stats, PHASE_RETURN);
 
             for (const auto& node : finishedBeam) {
-                // Find best return slot (Using Priority Map to avoid blocking future targets)
-                Coordinate bestSlot = findBestReturnSlot(node.yard, targetId, priorityMap, i);
+                // Find best return slot (Using Rank Table to avoid blocking future targets)
+                Coordinate bestSlot = findBestReturnSlot(node.yard, targetId, i);
 
                 if (bestSlot.row != -1) {
                     LogNode returnNode = node;
+                    returnNode.yard.setRankFrontier(i + 1); // The returned target is a "past" box now
                     returnNode.yard.initBox(targetId, bestSlot.row, bestSlot.bay, bestSlot.tier);
                     
                     MissionLog m;
@@ -285,14 +449,16 @@ public:
                     m.mission_status = "PLANNED";
                     m.created_time = baseTime;
 
-                    returnNode.history.push_back(m);
+                    returnNode.historyTail = history.append(returnNode.historyTail, m);
                     
                     // Return action does not increase g (usually), but reset f
                     returnNode.f = returnNode.g; 
 
                     returnPhaseBeam.push_back(returnNode);
+                    BBS_STAT(if (stats) { stats->candidates[CASE_RETURN]++; stats->bytesCopied += (long long)nodeBytes(returnNode); });
                 }
             }
+            BBS_STAT(if (stats) stats->addLayer(i, depthSafety + 1, (long long)finishedBeam.size(), (long long)returnPhaseBeam.size()));
 
             if (returnPhaseBeam.empty()) return {}; 
             currentBeam = returnPhaseBeam;
@@ -300,7 +466,7 @@ public:
 
         if (currentBeam.empty()) return {};
         
-        auto finalLogs = currentBeam[0].history;
+        auto finalLogs = history.reconstruct(currentBeam[0].historyTail);
         for(size_t i=0; i<finalLogs.size(); ++i) {
             finalLogs[i].mission_no = (int)(i + 1);
             finalLogs[i].mission_priority = (int)(i + 1);
@@ -311,22 +477,35 @@ public:
 
 private:
     // Internal Logic (For GA - Must match solveAndRecord logic!)
-    static int run_internal_logic(const YardSystem& initialYard, const std::vector<int>& retrievalSequence) {
+    static int run_internal_logic(const YardSystem& initialYard, const std::vector<int>& retrievalSequence,
+                                  CheckpointStore* store, std::vector<Checkpoint>* saved, bool* resumed) {
+         const std::vector<int>& ranks = buildRankTable(initialYard, retrievalSequence);
          std::vector<SearchNode> currentBeam;
-         currentBeam.push_back({initialYard, 0, 0});
-         
-         std::unordered_map<int, int> priorityMap;
-         for(size_t i=0; i<retrievalSequence.size(); ++i) priorityMap[retrievalSequence[i]] = (int)i;
+         int startIndex = 0;
+
+         const Checkpoint* resumeFrom = (store && store->enabled()) ? store->findLongestPrefix(retrievalSequence) : nullptr;
+         if (resumeFrom) {
+             // Continue after the shared prefix; re-attach this sequence's ranks (prefix boxes are "past")
+             currentBeam = resumeFrom->state;
+             startIndex = (int)resumeFrom->prefix.size();
+             for (auto& node : currentBeam) node.yard.attachRanks(ranks, startIndex);
+             *resumed = true;
+         } else {
+             currentBeam.push_back({initialYard, 0, 0});
+             if (DESTINATION_CANDIDATES > 0) currentBeam[0].yard.enableDestinationIndex();
+             currentBeam[0].yard.attachRanks(ranks);
+         }
 
-         for (int i = 0; i < retrievalSequence.size(); ++i) {
+         for (int i = startIndex; i < (int)retrievalSequence.size(); ++i) {
             int targetId = retrievalSequence[i];
             std::vector<SearchNode> finishedBeam;
             std::vector<SearchNode> processingBeam = currentBeam;
             int depth = 0;
             
             while(!processingBeam.empty()) {
-                std::vector<SearchNode> nextStep;
-                for(const auto& node : processingBeam) {
+                std::vector<MoveCandidate> candidates;
+                for(int k=0; k<(int)processingBeam.size(); ++k) {
+                    const SearchNode& node = processingBeam[k];
                     if(node.yard.isTop(targetId)) {
                         SearchNode dn = node; 
                         dn.yard.removeBox(targetId);
@@ -337,34 +516,40 @@ private:
                         if(blks.empty()) continue;
                         int bid = blks.back();
                         Coordinate pos = node.yard.getBoxPosition(bid);
-                        for(int r=0; r<node.yard.MAX_ROWS; ++r) {
-                            for(int b=0; b<node.yard.MAX_BAYS; ++b) {
-                                if(r==pos.row && b==pos.bay) continue;
-                                YardSystem ny = node.yard;
-                                if(ny.moveBox(pos.row, pos.bay, r, b)) {
-                                    // Calculate Penalty here too!
-                                    int penalty = calculateMovePenalty(node.yard, r, b, priorityMap, i);
-                                    nextStep.push_back({ny, node.g+1, node.g+1+penalty});
-                                }
-                            }
+                        for(int column : reshuffleDestinations(node.yard, pos)) {
+                            int r = column / node.yard.MAX_BAYS;
+                            int b = column % node.yard.MAX_BAYS;
+                            // Calculate Penalty here too!
+                            int penalty = calculateMovePenalty(node.yard, r, b, i);
+                            candidates.push_back({k, pos.row, pos.bay, r, b, node.g+1, node.g+1+penalty,
+                                                  node.yard.hashAfterMove(pos.row, pos.bay, r, b)});
                         }
                     }
                 }
-                if(!nextStep.empty()) {
-                    std::sort(nextStep.begin(), nextStep.end());
-                    if(nextStep.size() > BEAM_WIDTH) nextStep.resize(BEAM_WIDTH);
+                std::vector<int> survivors = selectSurvivors(candidates);
+                std::vector<SearchNode> nextStep;
+                nextStep.reserve(survivors.size());
+                for(int idx : survivors) {
+                    const MoveCandidate& c = candidates[idx];
+                    SearchNode child = processingBeam[c.parent];
+                    child.yard.moveBox(c.srcRow, c.srcBay, c.dstRow, c.dstBay);
+                    child.g = c.g;
+                    child.f = c.f;
+                    nextStep.push_back(std::move(child));
                 }
-                processingBeam = nextStep;
+                processingBeam = std::move(nextStep);
                 if(++depth > 30) break;
             }
             if(finishedBeam.empty()) return 99999;
+            keepTopK(finishedBeam, BEAM_WIDTH, nodeScore<SearchNode>); // Same cut as solveAndRecord
             
             // Phase 2 Sim (Return)
             std::vector<SearchNode> returnBeam;
             for(const auto& node : finishedBeam) {
-                Coordinate bestSlot = findBestReturnSlot(node.yard, targetId, priorityMap, i);
+                Coordinate bestSlot = findBestReturnSlot(node.yard, targetId, i);
                 if(bestSlot.row != -1) {
                     SearchNode rn = node;
+                    rn.yard.setRankFrontier(i + 1);
                     rn.yard.initBox(targetId, bestSlot.row, bestSlot.bay, bestSlot.tier);
                     rn.f = rn.g;
                     returnBeam.push_back(rn);
@@ -372,140 +557,163 @@ private:
             }
             if(returnBeam.empty()) return 99999;
             currentBeam = returnBeam;
+
+            // Checkpoint after target i (the full sequence is the fitness cache's job)
+            if (saved && store->enabled() && (i + 1) % CHECKPOINT_STRIDE == 0 && i + 1 < (int)retrievalSequence.size()) {
+                size_t bytes = sizeof(Checkpoint) + (i + 1) * sizeof(int);
+                for (const auto& node : currentBeam) bytes += sizeof(SearchNode) + node.yard.storage.size() * sizeof(int);
+                saved->push_back({std::vector<int>(retrievalSequence.begin(), retrievalSequence.begin() + i + 1), currentBeam, bytes});
+            }
          }
          if(currentBeam.empty()) return 99999;
          return currentBeam[0].g;
     }
 };
 
-// ==========================================
-// GA Module
-// ==========================================
-class GeneticAlgorithm {
-    struct Individual {
-        std::vector<int> sequence;
-        int fitness;
-    };
-    std::vector<Individual> population;
-    YardSystem yardRef;
-    std::mt19937 rng;
+// GA objective: reshuffle count of the BBS_Evaluator beam
+struct MoveCountObjective {
+    typedef std::vector<BBS_Evaluator::SearchNode> State;
 
-public:
-    GeneticAlgorithm(const YardSystem& yard, const std::vector<int>& targets) : yardRef(yard) {
-        rng.seed(std::chrono::system_clock::now().time_since_epoch().count());
-        population.resize(POPULATION_SIZE);
-        for (int i = 0; i < POPULATION_SIZE; ++i) {
-            population[i].sequence = targets;
-            std::shuffle(population[i].sequence.begin(), population[i].sequence.end(), rng);
-            population[i].fitness = std::numeric_limits<int>::max();
-        }
-    }
+    const YardSystem& yard;
 
-    void solve() {
-        for (int gen = 0; gen < MAX_GENERATIONS; ++gen) {
-            // Calculate Fitness
-            for (int i = 0; i < POPULATION_SIZE; ++i) {
-                if (population[i].fitness == std::numeric_limits<int>::max())
-                    population[i].fitness = BBS_Evaluator::evaluate(yardRef, population[i].sequence);
-            }
-            
-            // Sort
-            std::sort(population.begin(), population.end(), [](const Individual& a, const Individual& b){ return a.fitness < b.fitness; });
-            
-            if (gen % 10 == 0 || gen == MAX_GENERATIONS - 1) {
-                std::cout << "Gen " << std::setw(3) << gen << " | Best Cost: " << population[0].fitness << std::endl;
-                std::cout << " | Seq: [ ";
-                for (size_t i = 0; i < population[0].sequence.size(); ++i) {
-                    std::cout << population[0].sequence[i] << (i < population[0].sequence.size() - 1 ? ", " : "");
-                }
-                std::cout << " ]\n\n";
-            }
-            
-            // Evolution
-            std::vector<Individual> nextGen;
-            int eliteCount = POPULATION_SIZE * 0.1; 
-            if (eliteCount < 1) eliteCount = 1;
-            for(int i=0; i<eliteCount; ++i) nextGen.push_back(population[i]); // Elitism
-            
-            while(nextGen.size() < POPULATION_SIZE) {
-                // Tournament Selection
-                const auto& p1 = population[std::uniform_int_distribution<int>(0, POPULATION_SIZE/2)(rng)];
-                Individual child = p1;
-                
-                // Mutation
-                if(std::uniform_real_distribution<double>(0,1)(rng) < MUTATION_RATE) {
-                    int idx1 = std::uniform_int_distribution<int>(0, child.sequence.size()-1)(rng);
-                    int idx2 = std::uniform_int_distribution<int>(0, child.sequence.size()-1)(rng);
-                    std::swap(child.sequence[idx1], child.sequence[idx2]);
-                    child.fitness = std::numeric_limits<int>::max();
-                }
-                nextGen.push_back(child);
-            }
-            population = nextGen;
-        }
-    }
+    explicit MoveCountObjective(const YardSystem& initialYard) : yard(initialYard) {}
 
-    std::vector<int> getBestSequence() { return population[0].sequence; }
-    int getBestFitness() { return population[0].fitness; }
+    double evaluate(const std::vector<int>& seq) const { return BBS_Evaluator::evaluate(yard, seq); }
+
+    double evaluateResumable(const std::vector<int>& seq, BBS_Evaluator::CheckpointStore& store,
+                             std::vector<BBS_Evaluator::Checkpoint>& saved, bool& resumed) const {
+        return BBS_Evaluator::evaluateResumable(yard, seq, store, saved, resumed);
+    }
 };
 
 // ==========================================
-// Main Function
+// Mission Log Output (output_missions.csv)
 // ==========================================
-int main() {
-    auto totalStart = std::chrono::high_resolution_clock::now();
+// Reshuffle-count plan: one row per move, no timing
+static void writeMissionLog(const MoveCountObjective& objective, const std::vector<int>& bestSeq, const std::string& filename,
+                            SearchStats* stats) {
+    std::vector<BBS_Evaluator::MissionLog> logs = BBS_Evaluator::solveAndRecord(objective.yard, bestSeq, stats);
 
-    std::cout << "[Step 0] Loading Configuration..." << std::endl;
-    YardConfig config = DataLoader::loadYardConfig("yard_config.csv");
-    
-    // Check if configuration loaded successfully
-    if (config.max_row == 0) {
-        std::cerr << "Error: Could not load yard_config.csv. Please run generator first." << std::endl;
-        // Fallback (Safe defaults)
-        std::cout << "Using fallback defaults: 6x11x8, 400 boxes." << std::endl;
-        config = {6, 11, 8, 400};
-    } else {
-        std::cout << "Config Loaded: " << config.max_row << "x" << config.max_bay 
-                  << "x" << config.max_level << ", Capacity: " << config.total_boxes << std::endl;
-    }
+    std::ofstream outFile(filename);
+    outFile << "mission_no,mission_type,batch_id,parent_carrier_id,source_position,dest_position,mission_priority,mission_status,created_time\n";
+    for (const auto& m : logs) {
+        std::stringstream ssSrc, ssDst;
+        if (m.src.row == -1) ssSrc << "work station";
+        else ssSrc << "(" << m.src.row << ";" << m.src.bay << ";" << m.src.tier << ")";
+        if (m.dst.row == -1) ssDst << "work station";
+        else ssDst << "(" << m.dst.row << ";" << m.dst.bay << ";" << m.dst.tier << ")";
 
-    // 1. Load Yard Layout
-    std::cout << "[Step 1] Loading Yard Snapshot..." << std::endl;
-    auto yardData = DataLoader::loadYardSnapshot("mock_yard.csv");
-    if (yardData.empty()) { std::cerr << "Error: mock_yard.csv missing." << std::endl; return -1; }
-    
-    // [Critical Change] Initialize using config values
-    YardSystem yard(config.max_row, config.max_bay, config.max_level, config.total_boxes);
+        outFile << m.mission_no << "," << m.mission_type << "," << m.batch_id << "," << m.container_id << ","
+                << ssSrc.str() << "," << ssDst.str() << "," << m.mission_priority << "," << m.mission_status << "," << m.created_time << "\n";
+    }
+}
 
-    for (const auto& box : yardData) yard.initBox(box.container_id, box.row, box.bay, box.level);
+// Makespan plan: AGV assignment and timestamps per mission (README §6.2), same columns as main.py
+static void writeMissionLog(const std::vector<MissionLog>& logs, const std::string& filename) {
+    const char* typeNames[] = {"target", "reshuffle", "return"};
 
-    // 2. Load Missions
-    auto commandData = DataLoader::loadCommands("mock_commands.csv");
-    if (commandData.empty()) { std::cerr << "Error: mock_commands.csv missing." << std::endl; return -1; }
+    std::ofstream outFile(filename);
+    outFile << "mission_no,agv_id,mission_type,container_id,related_target_id,src_pos,dst_pos,start_time,end_time,makespan\n";
+    for (const auto& m : logs) {
+        std::stringstream ssSrc, ssDst;
+        if (m.src.row == -1) ssSrc << "work station (Port " << m.src.tier << ")";
+        else ssSrc << "(" << m.src.row << ";" << m.src.bay << ";" << m.src.tier << ")";
+        if (m.dst.row == -1) ssDst << "work station (Port " << m.dst.tier << ")";
+        else ssDst << "(" << m.dst.row << ";" << m.dst.bay << ";" << m.dst.tier << ")";
 
-    std::vector<int> targetBlockIds;
-    std::vector<int> originalPrioritySeq;
-    for (const auto& cmd : commandData) {
-        if (cmd.cmd_type == "target" && yard.getBoxPosition(cmd.parent_carrier_id).row != -1) {
-            targetBlockIds.push_back(cmd.parent_carrier_id);
-            originalPrioritySeq.push_back(cmd.parent_carrier_id);
-        }
+        outFile << m.mission_no << "," << m.agv_id << "," << typeNames[m.type_code] << "," << m.container_id << ","
+                << m.related_target_id << "," << ssSrc.str() << "," << ssDst.str() << "," << m.start_time_epoch << ","
+                << m.end_time_epoch << "," << m.makespan_snapshot << "\n";
     }
+}
+
+// Adaptive width: the width of every layer of the final plan's beam search
+static void writeBeamWidths(const std::vector<LayerWidth>& widths, const std::string& filename) {
+    if (widths.empty()) return;
+    std::ofstream outFile(filename);
+    outFile << "seq_idx,layer,width,candidates\n";
+    int minWidth = widths[0].width, maxWidth = widths[0].width;
+    double sum = 0;
+    for (const auto& w : widths) {
+        outFile << w.seqIdx << "," << w.layer << "," << w.width << "," << w.candidates << "\n";
+        minWidth = std::min(minWidth, w.width);
+        maxWidth = std::max(maxWidth, w.width);
+        sum += w.width;
+    }
+    std::cout << "Beam width per layer: min " << minWidth << ", mean " << std::fixed << std::setprecision(1) << sum / widths.size()
+              << std::defaultfloat << std::setprecision(6) << ", max " << maxWidth << " over " << widths.size()
+              << " layers (saved to '" << filename << "')" << std::endl;
+}
+
+static void writeMissionLog(const MakespanObjective& objective, const std::vector<int>& bestSeq, const std::string& filename,
+                            SearchStats* stats) {
+    std::vector<LayerWidth> widths;
+    writeMissionLog(objective.solver.solve(objective.yard, bestSeq, 0, nullptr, nullptr, stats, &widths), filename);
+    if (objective.solver.getConfig().adaptiveWidth) writeBeamWidths(widths, "beam_widths.csv");
+}
 
-    if (targetBlockIds.empty()) { std::cerr << "Error: No valid targets." << std::endl; return -1; }
+// ==========================================
+// Search Instrumentation (built with -DBBS_STATS): final plan's beam search
+// ==========================================
+static void printSearchStats(const SearchStats& stats) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    std::cout << "Search Layers      : " << stats.layers.size() << " (" << stats.nodesGenerated << " nodes generated, "
+              << stats.nodesKept << " kept)" << std::endl;
+    std::cout << "Candidates by Case :";
+    for (int c = 0; c < CASE_COUNT; ++c) std::cout << " " << SearchStats::caseName(c) << "=" << stats.candidates[c];
+    std::cout << std::endl;
+    ss << "Phase Time (ms)    :";
+    for (int p = 0; p < PHASE_COUNT; ++p) ss << " " << SearchStats::phaseName(p) << "=" << stats.phaseSec[p] * 1000.0;
+    std::cout << ss.str() << std::endl;
+    std::cout << "Bytes Copied       : " << stats.bytesCopied << " (" << (stats.bytesCopied >> 20) << " MB)" << std::endl;
+    if (stats.frontChecked > 0) {
+        std::cout << "Front Rule         : " << stats.frontChecked << " checked, " << stats.frontPruned << " pruned, "
+                  << stats.frontImproved << " improved" << std::endl;
+    }
+}
 
-    std::cout << "Targets to Retrieve: " << targetBlockIds.size() << std::endl;
+// Nodes generated / kept per layer
+static void writeSearchStats(const SearchStats& stats, const std::string& filename) {
+    std::ofstream outFile(filename);
+    outFile << "seq_idx,layer,generated,kept\n";
+    for (const auto& l : stats.layers) outFile << l.seqIdx << "," << l.layer << "," << l.generated << "," << l.kept << "\n";
+}
 
+// ==========================================
+// Experiment: baseline, GA optimization, mission log, report
+// ==========================================
+template <typename Objective>
+int runExperiment(const Objective& objective, const std::vector<int>& targetBlockIds, const std::vector<int>& originalPrioritySeq,
+                  unsigned int seed, const GAConfig& gaConfig, double timeBudget,
+                  std::chrono::high_resolution_clock::time_point totalStart) {
     // 3. Baseline Evaluation
     std::cout << "\n[Step 2] Calculating Original Sequence Cost..." << std::endl;
-    int originalCost = BBS_Evaluator::evaluate(yard, originalPrioritySeq);
+    double originalCost = objective.evaluate(originalPrioritySeq);
     std::cout << "Original Cost: " << originalCost << std::endl;
 
     // 4. GA Optimization
     std::cout << "\n[Step 3] Running GA Optimization..." << std::endl;
     auto gaStart = std::chrono::high_resolution_clock::now();
     
-    GeneticAlgorithm ga(yard, targetBlockIds);
+    GeneticAlgorithm<Objective> ga(objective, targetBlockIds, seed, gaConfig);
+    std::cout << "Workers: " << ga.getWorkerCount() << ", Seed: " << seed << ", Islands: " << ga.getIslandCount() << std::endl;
+    ga.setTimeBudget(timeBudget);
+
+    // Convergence trace: one line whenever the best cost improves
+    double lastReported = std::numeric_limits<double>::infinity();
+    int lastGeneration = 0;
+    ga.setProgressCallback([&](const GAProgress& p) {
+        lastGeneration = p.generation;
+        if (p.bestCost < lastReported) {
+            lastReported = p.bestCost;
+            std::cout << "  [progress] " << std::fixed << std::setprecision(3) << p.elapsedSec << "s gen " << p.generation
+                      << std::defaultfloat << std::setprecision(6) << " best " << p.bestCost
+                      << " (" << std::fixed << std::setprecision(0) << p.evalsPerSec << " evals/s)"
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+        }
+        return true;
+    });
     ga.solve();
     
     auto gaEnd = std::chrono::high_resolution_clock::now();
@@ -513,25 +721,13 @@ int main() {
 
     // 5. Compile Results
     std::vector<int> bestSeq = ga.getBestSequence();
-    int bestCost = ga.getBestFitness();
+    double bestCost = ga.getBestFitness();
 
     // 6. Generate Detailed Mission Logs
     std::cout << "\n[Step 4] Generating Execution Logs..." << std::endl;
-    std::vector<MissionLog> logs = BBS_Evaluator::solveAndRecord(yard, bestSeq);
-
-    std::ofstream outFile("output_missions.csv");
-    outFile << "mission_no,mission_type,batch_id,parent_carrier_id,source_position,dest_position,mission_priority,mission_status,created_time\n";
-    for (const auto& m : logs) {
-        std::stringstream ssSrc, ssDst;
-        if (m.src.row == -1) ssSrc << "work station";
-        else ssSrc << "(" << m.src.row << ";" << m.src.bay << ";" << m.src.tier << ")";
-        if (m.dst.row == -1) ssDst << "work station";
-        else ssDst << "(" << m.dst.row << ";" << m.dst.bay << ";" << m.dst.tier << ")";
-
-        outFile << m.mission_no << "," << m.mission_type << "," << m.batch_id << "," << m.container_id << ","
-                << ssSrc.str() << "," << ssDst.str() << "," << m.mission_priority << "," << m.mission_status << "," << m.created_time << "\n";
-    }
-    outFile.close();
+    SearchStats searchStats;
+    writeMissionLog(objective, bestSeq, "output_missions.csv", &searchStats);
+    if (SearchStats::compiledIn()) writeSearchStats(searchStats, "search_stats.csv");
 
     auto totalEnd = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> totalTime = totalEnd - totalStart;
@@ -541,11 +737,30 @@ int main() {
     // ==========================================
     std::cout << "\n================ EXPERIMENT REPORT ================" << std::endl;
     std::cout << "Optimization Time  : " << gaTime.count() << " sec" << std::endl;
+    std::cout << "Worker Threads     : " << ga.getWorkerCount() << std::endl;
+    std::cout << "GA Islands         : " << ga.getIslandCount() << std::endl;
+    std::cout << "GA Generations     : " << lastGeneration + 1;
+    if (timeBudget > 0) std::cout << " (time budget " << timeBudget << " sec)";
+    std::cout << std::endl;
+    std::cout << "Random Seed        : " << seed << std::endl;
+    long long cacheLookups = ga.getCacheHits() + ga.getCacheMisses();
+    std::stringstream ssHitRate;
+    ssHitRate << std::fixed << std::setprecision(1) << (cacheLookups ? 100.0 * ga.getCacheHits() / cacheLookups : 0.0);
+    std::cout << "Fitness Cache      : " << ga.getCacheHits() << " hits / " << ga.getCacheMisses() << " misses ("
+              << ssHitRate.str() << "% hit rate)" << std::endl;
+    std::stringstream ssSkipped;
+    ssSkipped << std::fixed << std::setprecision(1) << 100.0 * ga.getSkippedTargetRatio();
+    std::cout << "Prefix Resume      : " << ga.getResumedEvaluations() << " of " << ga.getResumeLookups() << " evaluations, "
+              << ssSkipped.str() << "% of targets skipped (" << (ga.getCheckpointMemory() >> 20) << " MB)" << std::endl;
     std::cout << "Total Elapsed Time : " << totalTime.count() << " sec" << std::endl;
+    if (SearchStats::compiledIn()) {
+        std::cout << "---------------------------------------------------" << std::endl;
+        printSearchStats(searchStats);
+    }
     std::cout << "---------------------------------------------------" << std::endl;
     std::cout << "Original Cost      : " << originalCost << std::endl;
     std::cout << "Optimized Cost     : " << bestCost << std::endl;
-    double improvement = (double)(originalCost - bestCost) / originalCost * 100.0;
+    double improvement = (originalCost - bestCost) / originalCost * 100.0;
     std::cout << "Improvement        : " << std::fixed << std::setprecision(2) << improvement << "%" << std::endl;
     std::cout << "---------------------------------------------------" << std::endl;
     std::cout << "Final Target Sequence (Optimized Order):" << std::endl;
@@ -555,6 +770,223 @@ int main() {
     }
     std::cout << " ]" << std::endl;
     std::cout << "Detailed log saved to 'output_missions.csv'" << std::endl;
+    if (SearchStats::compiledIn()) std::cout << "Per-layer search stats saved to 'search_stats.csv'" << std::endl;
+
+    return 0;
+}
+
+// ==========================================
+// Online Mode (--online): the commands replayed as a stream by create_time (README §4.4)
+// A replan runs whenever a command arrives or an AGV runs out of committed missions.
+// ==========================================
+static int runOnline(const YardSystem& yard, const std::vector<Command>& commands, const SolverConfig& solverConfig,
+                     const RollingConfig& rollingConfig, std::chrono::high_resolution_clock::time_point totalStart) {
+    std::vector<Command> stream = commands;
+    std::stable_sort(stream.begin(), stream.end(), [](const Command& a, const Command& b) { return a.create_time < b.create_time; });
+
+    std::cout << "\n[Step 2] Rolling-Horizon Replanning (window " << rollingConfig.windowTargets << " targets, commit "
+              << rollingConfig.commitMissions << " missions)..." << std::endl;
+    RollingPlanner planner(yard, solverConfig, rollingConfig);
+    std::vector<MissionLog> logs;
+    std::vector<double> latencies;
+    int targets = 0;
+    size_t next = 0;
+    long long now = stream.empty() ? MISSION_EPOCH : stream[0].create_time;
+
+    while (next < stream.size() || planner.pendingCount() > 0) {
+        while (next < stream.size() && stream[next].create_time <= now) {
+            if (planner.addCommand(stream[next])) targets++;
+            next++;
+        }
+        std::vector<MissionLog> committed = planner.replan(now);
+        const ReplanReport& report = planner.lastReport();
+        if (report.deadEnd) { std::cerr << "Error: no complete plan for the window at " << now << std::endl; return -1; }
+        if (report.windowTargets > 0) latencies.push_back(report.latencySec);
+        logs.insert(logs.end(), committed.begin(), committed.end());
+
+        // Next event: the next arrival, or the first AGV that runs out of committed missions
+        long long nextEvent = next < stream.size() ? stream[next].create_time : std::numeric_limits<long long>::max();
+        if (planner.pendingCount() > 0) {
+            double freeAt = std::numeric_limits<double>::infinity();
+            for (const auto& agv : planner.committedState().agvs) freeAt = std::fmin(freeAt, agv.availableTime);
+            nextEvent = std::min(nextEvent, (long long)freeAt + MISSION_EPOCH);
+        }
+        now = std::max(now, nextEvent);
+    }
+
+    writeMissionLog(logs, "output_missions.csv");
+    auto totalEnd = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> totalTime = totalEnd - totalStart;
+
+    double sum = 0, worst = 0, tailSum = 0;
+    size_t tail = std::max<size_t>(1, latencies.size() / 10);
+    for (size_t i = 0; i < latencies.size(); ++i) {
+        sum += latencies[i];
+        worst = std::max(worst, latencies[i]);
+        if (i + tail >= latencies.size()) tailSum += latencies[i];
+    }
 
+    std::cout << "\n================ ONLINE REPORT ================" << std::endl;
+    std::cout << "Targets Streamed   : " << targets << " (" << stream.size() << " commands)" << std::endl;
+    std::cout << "Replans            : " << latencies.size() << std::endl;
+    std::cout << "Missions Committed : " << logs.size() << std::endl;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    if (!latencies.empty()) {
+        ss << "Replan Latency (ms): avg " << 1000.0 * sum / latencies.size() << ", max " << 1000.0 * worst
+           << ", last " << tail << " avg " << 1000.0 * tailSum / tail;
+        std::cout << ss.str() << std::endl;
+    }
+    std::cout << "Makespan           : " << (logs.empty() ? 0.0 : logs.back().makespan_snapshot) << std::endl;
+    std::cout << "Total Elapsed Time : " << totalTime.count() << " sec" << std::endl;
+    std::cout << "Detailed log saved to 'output_missions.csv'" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
+
+// ==========================================
+// Main Function
+// ==========================================
+int main(int argc, char* argv[]) {
+    auto totalStart = std::chrono::high_resolution_clock::now();
+
+    // Optional arguments: [Workers] [Seed] [Islands] [TimeBudgetSec] [moves|makespan] [--instance FILE] [--online]
+    std::string instanceFile; // binary instance (.brp) instead of the three CSVs
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--instance") == 0 && i + 1 < argc) {
+            instanceFile = argv[i + 1];
+            for (int j = i; j + 2 <= argc; ++j) argv[j] = argv[j + 2];
+            argc -= 2;
+            break;
+        }
+    }
+    bool online = false; // stream the commands by create_time through the rolling-horizon planner
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--online") == 0) {
+            online = true;
+            for (int j = i; j + 1 <= argc; ++j) argv[j] = argv[j + 1];
+            argc -= 1;
+            break;
+        }
+    }
+    int workers = EVAL_WORKERS;
+    unsigned int seed = RANDOM_SEED;
+    int islandCount = ISLAND_COUNT;
+    double timeBudget = TIME_BUDGET_SEC;
+    bool optimizeMakespan = OPTIMIZE_MAKESPAN;
+    if (argc > 6 || (argc > 5 && std::strcmp(argv[5], "moves") != 0 && std::strcmp(argv[5], "makespan") != 0)) {
+        std::cerr << "Usage: " << argv[0] << " [Workers] [Seed] [Islands] [TimeBudgetSec] [moves|makespan] [--instance FILE] [--online]" << std::endl;
+        std::cerr << "Example: " << argv[0] << " 32 12345 4 2.5 makespan" << std::endl;
+        return 1;
+    }
+    if (argc > 1) workers = std::atoi(argv[1]);
+    if (argc > 2) seed = (unsigned int)std::strtoul(argv[2], nullptr, 10);
+    if (argc > 3) islandCount = std::atoi(argv[3]);
+    if (argc > 4) timeBudget = std::atof(argv[4]);
+    if (argc > 5) optimizeMakespan = std::strcmp(argv[5], "makespan") == 0;
+    if (seed == 0) seed = (unsigned int)std::chrono::system_clock::now().time_since_epoch().count();
+
+    YardConfig config;
+    YardSystem yard;
+    std::vector<Command> commandData;
+    if (!instanceFile.empty()) {
+        // Steps 0-2 from one binary file: the grid is copied straight into the yard layout
+        std::cout << "[Step 0] Loading Binary Instance " << instanceFile << "..." << std::endl;
+        YardInstance instance;
+        std::string error;
+        if (!InstanceFile::load(instanceFile, instance, error)) { std::cerr << "Error: " << error << std::endl; return -1; }
+        config = instance.config;
+        yard = std::move(instance.yard);
+        commandData = std::move(instance.commands);
+        std::cout << "Config Loaded: " << config.max_row << "x" << config.max_bay
+                  << "x" << config.max_level << ", Capacity: " << config.total_boxes
+                  << ", Time: travel " << config.time_travel_unit << "s / handle " << config.time_handle
+                  << "s / process " << config.time_process << "s" << std::endl;
+    } else {
+        std::cout << "[Step 0] Loading Configuration..." << std::endl;
+        config = DataLoader::loadYardConfig("yard_config.csv");
+        
+        // Check if configuration loaded successfully
+        if (config.max_row == 0) {
+            std::cerr << "Error: Could not load yard_config.csv. Please run generator first." << std::endl;
+            // Fallback (Safe defaults)
+            std::cout << "Using fallback defaults: 6x11x8, 400 boxes." << std::endl;
+            config = {6, 11, 8, 400, 5.0, 30.0, 10.0};
+        } else {
+            std::cout << "Config Loaded: " << config.max_row << "x" << config.max_bay 
+                      << "x" << config.max_level << ", Capacity: " << config.total_boxes
+                      << ", Time: travel " << config.time_travel_unit << "s / handle " << config.time_handle
+                      << "s / process " << config.time_process << "s" << std::endl;
+        }
+
+        // 1. Load Yard Layout
+        std::cout << "[Step 1] Loading Yard Snapshot..." << std::endl;
+        auto yardData = DataLoader::loadYardSnapshot("mock_yard.csv");
+        if (yardData.empty()) { std::cerr << "Error: mock_yard.csv missing." << std::endl; return -1; }
+        
+        // [Critical Change] Initialize using config values
+        yard = YardSystem(config.max_row, config.max_bay, config.max_level, config.total_boxes);
+
+        for (const auto& box : yardData) yard.initBox(box.container_id, box.row, box.bay, box.level);
+
+        // 2. Load Missions
+        commandData = DataLoader::loadCommands("mock_commands.csv");
+        if (commandData.empty()) { std::cerr << "Error: mock_commands.csv missing." << std::endl; return -1; }
+    }
+
+    std::vector<int> targetBlockIds;
+    std::vector<int> originalPrioritySeq;
+    for (const auto& cmd : commandData) {
+        if (cmd.cmd_type == "target" && yard.getBoxPosition(cmd.parent_carrier_id).row != -1) {
+            targetBlockIds.push_back(cmd.parent_carrier_id);
+            originalPrioritySeq.push_back(cmd.parent_carrier_id);
+        }
+    }
+
+    if (targetBlockIds.empty()) { std::cerr << "Error: No valid targets." << std::endl; return -1; }
+
+    std::cout << "Targets to Retrieve: " << targetBlockIds.size() << std::endl;
+
+    GAConfig gaConfig;
+    gaConfig.populationSize = POPULATION_SIZE;
+    gaConfig.maxGenerations = MAX_GENERATIONS;
+    gaConfig.mutationRate = MUTATION_RATE;
+    gaConfig.crossoverRate = CROSSOVER_RATE;
+    gaConfig.islandCount = islandCount;
+    gaConfig.migrationInterval = MIGRATION_INTERVAL;
+    gaConfig.migrantCount = MIGRANT_COUNT;
+    gaConfig.workers = workers;
+    gaConfig.fitnessCacheSize = FITNESS_CACHE_SIZE;
+    gaConfig.checkpointBudgetMB = CHECKPOINT_BUDGET_MB;
+
+    if (optimizeMakespan || online) {
+        // Time parameters from yard_config.csv (README §2.1 defaults when absent), 3 AGVs, 5 ports
+        SolverConfig solverConfig;
+        solverConfig.timeTravelUnit = config.time_travel_unit;
+        solverConfig.timeHandle = config.time_handle;
+        solverConfig.timeProcess = config.time_process;
+        solverConfig.beamWidth = MAKESPAN_BEAM_WIDTH;
+        solverConfig.dedupStates = DEDUP_STATES;
+        solverConfig.frontRule = FRONT_RULE_MODE;
+        solverConfig.checkpointStride = CHECKPOINT_STRIDE;
+        solverConfig.adaptiveWidth = ADAPTIVE_BEAM_WIDTH;
+        solverConfig.minBeamWidth = MIN_BEAM_WIDTH;
+        solverConfig.widthGap = BEAM_WIDTH_GAP;
+        solverConfig.nodeBudget = BEAM_NODE_BUDGET;
+        solverConfig.destinationCandidates = MAKESPAN_DESTINATIONS;
+        std::cout << "Objective: makespan (" << solverConfig.agvCount << " AGVs, " << solverConfig.portCount
+                  << " ports, beam " << (solverConfig.adaptiveWidth ? "adaptive <= " : "") << solverConfig.beamWidth << ")" << std::endl;
+        if (online) {
+            RollingConfig rollingConfig;
+            rollingConfig.windowTargets = ONLINE_WINDOW_TARGETS;
+            rollingConfig.commitMissions = ONLINE_COMMIT_MISSIONS;
+            rollingConfig.workers = workers;
+            rollingConfig.seed = seed;
+            rollingConfig.timeBudget = timeBudget;
+            return runOnline(yard, commandData, solverConfig, rollingConfig, totalStart);
+        }
+        MakespanObjective objective(yard, solverConfig);
+        return runExperiment(objective, targetBlockIds, originalPrioritySeq, seed, gaConfig, timeBudget, totalStart);
+    }
+    MoveCountObjective objective(yard);
+    return runExperiment(objective, targetBlockIds, originalPrioritySeq, seed, gaConfig, timeBudget, totalStart);
+}
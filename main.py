@@ -1,4 +1,5 @@
 import csv
+import os
 import time
 import bs_solver # Beam Search
 # import mcts_solver # Monte Carlo Tree Search
@@ -61,8 +62,13 @@ job_sequence = [
 def main():
     start_t = time.time()
     
-    # 2. Load Data
-    config, boxes, commands = load_csv_data()
+    # 2. Load Data (BRP_INSTANCE=file.brp: binary instance instead of the CSVs;
+    #    `boxes` is then a PyYard that stays in C++ and goes to the solver as is)
+    instance_file = os.environ.get('BRP_INSTANCE')
+    if instance_file:
+        config, boxes, commands = bs_solver.load_instance(instance_file)
+    else:
+        config, boxes, commands = load_csv_data()
     
     # 3. Configure Solver (bs/mcts)
 
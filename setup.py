@@ -1,15 +1,23 @@
 # setup.py
 from setuptools import setup, Extension
 from Cython.Build import cythonize
+import os
 import numpy
 
+# BBS_STATS=1 python setup.py build_ext --inplace: compile in the beam search counters (SearchStats.h)
+define_macros = [("BBS_STATS", "1")] if os.environ.get("BBS_STATS") == "1" else []
+
 extensions = [
-    # 舊的 Beam Search Solver
+    # Beam Search Solver (thin binding over MakespanSolver.h)
     Extension(
         "bs_solver",
         sources=["bs_solver.pyx"],
+        depends=["MakespanSolver.h", "YardSystem.h", "BeamSelect.h", "PrefixCheckpoint.h", "SearchStats.h",
+                 "InstanceFile.h", "DataLoader.h", "GeneticAlgorithm.h", "RollingPlanner.h", "MissionSimulator.h"],
         language="c++",
-        extra_compile_args=["-std=c++11", "-O3"],
+        define_macros=define_macros,
+        extra_compile_args=["-std=c++11", "-O3", "-fopenmp"],
+        extra_link_args=["-fopenmp"],
     ),
 
 ]